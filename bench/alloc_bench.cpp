@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <decaf/compile.hpp>
+
+/*
+    Heap allocations and time for whole compiles of a synthetic program.
+
+    Every operator new in the process is counted, so the numbers cover the
+    lexer, both trees, the symbol table and code gen along with the strings
+    and containers inside them.
+
+    Usage: alloc-bench [functions] [rounds]
+        functions   functions in the generated program (default 2000)
+        rounds      compiles per mode (default 5)
+*/
+
+static std::size_t numAllocations = 0;
+static std::size_t numBytes = 0;
+
+void* operator new(std::size_t size)
+{
+    numAllocations++;
+    numBytes += size;
+
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+const char *functionTemplate =
+    "int f%d(int a, int b) {\n"
+    "    int c;\n"
+    "    c = a * b + a - b / 2 + (a %% 3) * (b - a);\n"
+    "    while (c > 100) { c = c - a; }\n"
+    "    if (c == 0 || a != b) Print(\"c is \", c);\n"
+    "    return c;\n"
+    "}\n";
+
+std::string generate(int numFunctions)
+{
+    std::string program;
+    char buffer[512];
+
+    for (int i = 0; i < numFunctions; i++)
+    {
+        std::snprintf(buffer, sizeof(buffer), functionTemplate, i);
+        program += buffer;
+    }
+
+    program += "void main() { Print(f1(1, 2)); }\n";
+
+    return program;
+}
+
+void run(const char *name, Decaf::Mode mode, const std::string &source, int rounds)
+{
+    Decaf::Options options;
+    options.mode = mode;
+
+    std::size_t allocations = numAllocations;
+    std::size_t bytes = numBytes;
+    bool success = true;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < rounds; i++)
+        success = Decaf::compile(source, options).success && success;
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << ((success) ? "" : " (compile failed)") << std::endl
+              << "  allocations:    " << (numAllocations - allocations) / rounds << " per compile" << std::endl
+              << "  bytes:          " << (numBytes - bytes) / rounds << " per compile" << std::endl
+              << "  time:           " << elapsed.count() / rounds << " s per compile" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    int numFunctions = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    int rounds = (argc > 2) ? std::atoi(argv[2]) : 5;
+
+    std::string source = generate(numFunctions);
+
+    run("parser", Decaf::Mode::Parser, source, rounds);
+    run("semantic-check", Decaf::Mode::SemanticCheck, source, rounds);
+    run("code-gen", Decaf::Mode::CodeGen, source, rounds);
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <locale>
+#include <sstream>
+#include <string>
+
+#include <lexer/predicates.hpp>
+
+/*
+    Character classification as the lexer did it before the class table,
+    kept here only to compare against
+*/
+namespace Legacy {
+    struct isAlpha
+    {
+        bool operator() (const char &c) const
+        {
+            std::locale locale;
+            return std::isalpha(c, locale);
+        }
+    };
+
+    struct isIdentifier
+    {
+        bool operator() (const char &c) const
+        {
+            std::locale locale;
+            return std::isalnum(c, locale) || c == '_';
+        }
+    };
+
+    struct isNumber
+    {
+        bool operator() (const char &c) const
+        {
+            std::locale locale;
+            return std::isdigit(c, locale);
+        }
+    };
+
+    struct isOperator
+    {
+        bool operator() (const char &c) const
+        {
+            std::string operators("+-*/%<>=!&|");
+            return operators.find(c) != std::string::npos;
+        }
+    };
+
+    struct isSeparator
+    {
+        bool operator() (const char &c) const
+        {
+            std::string operators(";.,{}()");
+            return operators.find(c) != std::string::npos;
+        }
+    };
+
+    struct isWhiteSpace
+    {
+        bool operator() (const char &c) const
+        {
+            std::string characters(" \t\n");
+            return characters.find(c) != std::string::npos;
+        }
+    };
+}
+
+const char *sampleProgram =
+    "int fib(int n) {\n"
+    "    // recursive fibonacci\n"
+    "    if (n <= 1) return n;\n"
+    "    return fib(n - 1) + fib(n - 2);\n"
+    "}\n"
+    "void main() {\n"
+    "    double ratio_value;\n"
+    "    ratio_value = 1.618E+0 * 2.0;\n"
+    "    Print(\"fib: \", fib(20), ratio_value);\n"
+    "    while (true && !false) { break; }\n"
+    "}\n";
+
+/*
+    Walk the buffer the way the lexer does: classify the first character of
+    a run, then take characters while the run's predicate holds
+*/
+template<typename Alpha, typename Ident, typename Number, typename Op, typename Sep, typename White>
+std::size_t scan(const std::string &text)
+{
+    Alpha alpha; Ident ident; Number number; Op op; Sep sep; White white;
+    std::size_t runs = 0;
+    std::size_t i = 0;
+
+    while (i < text.size())
+    {
+        char c = text[i++];
+
+        if (white(c))
+            while (i < text.size() && white(text[i])) i++;
+        else if (alpha(c))
+            while (i < text.size() && ident(text[i])) i++;
+        else if (number(c))
+            while (i < text.size() && number(text[i])) i++;
+        else if (op(c) || sep(c))
+        {
+            // operators and separators are runs of one
+        }
+
+        runs++;
+    }
+
+    return runs;
+}
+
+template<typename Scan>
+void report(const char *name, const std::string &text, int iterations, Scan scanner)
+{
+    std::size_t runs = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++)
+        runs += scanner(text);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double chars = static_cast<double>(text.size()) * iterations;
+
+    std::cout << name << ": "
+        << static_cast<long long>(chars / elapsed.count()) << " chars/s"
+        << " (" << elapsed.count() << " s, " << runs << " runs)" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::string text;
+
+    if (argc > 1)
+    {
+        std::ifstream file(argv[1]);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        text = contents.str();
+    }
+
+    // synthesize roughly 4MB of input when no file is given
+    if (text.empty())
+    {
+        while (text.size() < (4u << 20))
+            text += sampleProgram;
+    }
+
+    int iterations = 5;
+
+    report("locale predicates", text, iterations,
+        scan<Legacy::isAlpha, Legacy::isIdentifier, Legacy::isNumber,
+             Legacy::isOperator, Legacy::isSeparator, Legacy::isWhiteSpace>);
+
+    report("class table", text, iterations,
+        scan<isAlpha, isIdentifier, isNumber, isOperator, isSeparator, isWhiteSpace>);
+
+    return 0;
+}
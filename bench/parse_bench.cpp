@@ -0,0 +1,154 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <lexer/lexer.hpp>
+#include <parser/TreeGeneration.hpp>
+#include <AST/ASTGeneration.hpp>
+#include <AST/ParseTreeVisitor.hpp>
+
+/*
+    Parse throughput on expression heavy programs and on programs of many
+    small functions, lexed from memory.
+
+    Usage: parse-bench [depth] [terms] [functions]
+        depth       parentheses nested in each expression of the nested run (default 64)
+        terms       operands in each expression of the long run (default 10000)
+        functions   functions in the generated file of the functions run (default 5000)
+*/
+
+const char *operators[] = { " + ", " * ", " - ", " / " };
+
+// (b - (c * (b + a))) ... nested depth deep, alternating operators
+std::string nestedExpression(int depth)
+{
+    std::string expr("a");
+
+    for (int d = 0; d < depth; d++)
+        expr = std::string("(") + ((d % 2) ? "b" : "c") + operators[d % 4] + expr + ")";
+
+    return expr;
+}
+
+// a + b * c - a / b ... with numTerms operands and no parentheses
+std::string longExpression(int numTerms)
+{
+    const char *operands[] = { "a", "b", "c" };
+    std::string expr("a");
+
+    for (int t = 1; t < numTerms; t++)
+        expr += std::string(operators[t % 4]) + operands[t % 3];
+
+    return expr;
+}
+
+std::string generate(const std::string &expr, int numStatements)
+{
+    std::string statement = "    x = " + expr + ";\n";
+    std::string program("void main() {\n    int a;\n    int b;\n    int c;\n    int x;\n");
+
+    for (int i = 0; i < numStatements; i++)
+        program += statement;
+
+    program += "}\n";
+
+    return program;
+}
+
+// numFunctions functions of loops, conditions and calls, as a generator would write
+std::string generateFunctions(int numFunctions)
+{
+    std::string program("int g;\n");
+
+    for (int i = 0; i < numFunctions; i++)
+    {
+        std::string name = "f" + std::to_string(i);
+
+        program += "int " + name + "(int a, int b) {\n    int x;\n    x = a * b + g;\n"
+                   "    while (x > 0) {\n        if (x % 2 == 0) { g = g + x / 2; } else { g = g - 1; }\n"
+                   "        x = x - 1;\n    }\n    return " + name + "(x, -b);\n}\n";
+    }
+
+    return program + "void main() {\n    Print(f0(1, 2));\n}\n";
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void run(const char *name, const std::string &source)
+{
+    // lexing alone, the parser pulls tokens itself so its time includes this
+    double lexSeconds;
+    std::size_t numTokens;
+    {
+        Scanner::Lexer lexer(source.data(), source.data() + source.size());
+
+        auto start = std::chrono::steady_clock::now();
+        numTokens = lexer.tokenizeAll().size();
+        lexSeconds = secondsSince(start);
+    }
+
+    Scanner::Lexer lexer(source.data(), source.data() + source.size());
+    Common::Arena arena;
+
+    auto start = std::chrono::steady_clock::now();
+    Parser::Program *program = Parser::treeGeneration(&lexer, arena);
+    double seconds = secondsSince(start);
+
+    // the AST the later passes take, by converting the parse tree and straight from tokens
+    start = std::chrono::steady_clock::now();
+    AST::convert(program, arena);
+    double convertSeconds = secondsSince(start);
+
+    Scanner::Lexer astLexer(source.data(), source.data() + source.size());
+    Common::Arena astArena;
+
+    start = std::chrono::steady_clock::now();
+    AST::astGeneration(&astLexer, astArena);
+    double astSeconds = secondsSince(start);
+
+    // recognizing alone, the floor the builders are measured against
+    Scanner::Lexer syntaxLexer(source.data(), source.data() + source.size());
+
+    start = std::chrono::steady_clock::now();
+    Parser::syntaxCheck(&syntaxLexer);
+    double syntaxSeconds = secondsSince(start);
+
+    // function bodies spread over every core, after lexing the whole file
+    unsigned numThreads = std::thread::hardware_concurrency();
+    Scanner::Lexer parallelLexer(source.data(), source.data() + source.size());
+    Common::Arena parallelArena;
+
+    start = std::chrono::steady_clock::now();
+    AST::parallelAstGeneration(&parallelLexer, parallelArena, numThreads);
+    double parallelSeconds = secondsSince(start);
+
+    std::cout << name << std::endl
+              << "  tokens:         " << numTokens << std::endl
+              << "  lex time:       " << lexSeconds << " s" << std::endl
+              << "  parse time:     " << seconds << " s"
+              << ((program == nullptr) ? " (parse failed)" : "") << std::endl
+              << "  throughput:     " << numTokens / seconds / 1e6 << " M tokens/s" << std::endl
+              << "  tree to AST:    " << seconds + convertSeconds << " s" << std::endl
+              << "  direct AST:     " << astSeconds << " s" << std::endl
+              << "  syntax only:    " << syntaxSeconds << " s" << std::endl
+              << "  parallel AST:   " << parallelSeconds << " s (" << numThreads << " threads)" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    int depth = (argc > 1) ? std::atoi(argv[1]) : 64;
+    int numTerms = (argc > 2) ? std::atoi(argv[2]) : 10000;
+    int numFunctions = (argc > 3) ? std::atoi(argv[3]) : 5000;
+
+    run("nested", generate(nestedExpression(depth), 20000));
+    run("long", generate(longExpression(numTerms), 2000000 / numTerms));
+    run("functions", generateFunctions(numFunctions));
+
+    return 0;
+}
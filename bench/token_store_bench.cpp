@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <lexer/lexer.hpp>
+#include <parser/TreeGeneration.hpp>
+
+/*
+    Token memory and parse time on a synthetic program of about 1M tokens.
+
+    Usage: token-store-bench [path]
+        path    where to write the generated program (kept afterwards so
+                other builds can be timed on the same input)
+*/
+
+// each function is 68 tokens
+const char *functionTemplate =
+    "int f%d(int a, int b) {\n"
+    "    int c;\n"
+    "    c = a * b + a - b / 2 + (a %% 3) * (b - a);\n"
+    "    while (c > 100) { c = c - a; }\n"
+    "    if (c == 0 || a != b) return a;\n"
+    "    return c;\n"
+    "}\n";
+
+std::string generate(std::size_t numFunctions)
+{
+    std::string program;
+    char buffer[512];
+
+    for (std::size_t i = 0; i < numFunctions; i++)
+    {
+        std::snprintf(buffer, sizeof(buffer), functionTemplate, static_cast<int>(i));
+        program += buffer;
+    }
+
+    program += "void main() { Print(f1(1, 2)); }\n";
+
+    return program;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char **argv)
+{
+    std::string path = (argc > 1) ? argv[1] : "token-store-bench.decaf";
+
+    {
+        std::ofstream out(path);
+        out << generate(1000000 / 68);
+    }
+
+    // lex everything to measure the store on its own
+    {
+        Scanner::Lexer lexer(path);
+
+        auto start = std::chrono::steady_clock::now();
+        while (lexer.getNextToken().type() != Scanner::Token::Type::END);
+        double seconds = secondsSince(start);
+
+        const Scanner::TokenStore &store = lexer.tokenStore();
+
+        std::cout << "tokens:           " << store.size() << std::endl
+                  << "lex time:         " << seconds << " s" << std::endl
+                  << "handle size:      " << sizeof(Scanner::Token) << " bytes" << std::endl
+                  << "store memory:     " << store.memoryUsage() << " bytes ("
+                  << static_cast<double>(store.memoryUsage()) / store.size() << " per token)" << std::endl;
+    }
+
+    // full parse tree generation with a fresh lexer
+    {
+        Scanner::Lexer lexer(path);
+        Common::Arena arena;
+
+        auto start = std::chrono::steady_clock::now();
+        Parser::Program *program = Parser::treeGeneration(&lexer, arena);
+        double seconds = secondsSince(start);
+
+        std::cout << "parse time:       " << seconds << " s"
+                  << ((program == nullptr) ? " (parse failed)" : "") << std::endl;
+    }
+
+    if (argc < 2)
+        std::remove(path.c_str());
+
+    return 0;
+}
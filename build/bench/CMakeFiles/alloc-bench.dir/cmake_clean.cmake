@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/alloc-bench"
+  "../bin/alloc-bench.pdb"
+  "CMakeFiles/alloc-bench.dir/alloc_bench.cpp.o"
+  "CMakeFiles/alloc-bench.dir/alloc_bench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/alloc-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/char-class-bench"
+  "../bin/char-class-bench.pdb"
+  "CMakeFiles/char-class-bench.dir/char_class_bench.cpp.o"
+  "CMakeFiles/char-class-bench.dir/char_class_bench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/char-class-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
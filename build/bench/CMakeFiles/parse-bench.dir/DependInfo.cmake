@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/parse_bench.cpp" "bench/CMakeFiles/parse-bench.dir/parse_bench.cpp.o" "gcc" "bench/CMakeFiles/parse-bench.dir/parse_bench.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/build/src/lexer/CMakeFiles/Lexer.dir/DependInfo.cmake"
+  "/root/repo/build/src/parser/CMakeFiles/Parser.dir/DependInfo.cmake"
+  "/root/repo/build/src/AST/CMakeFiles/AST.dir/DependInfo.cmake"
+  "/root/repo/build/src/token/CMakeFiles/Token.dir/DependInfo.cmake"
+  "/root/repo/build/src/visitor/CMakeFiles/Visitor.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
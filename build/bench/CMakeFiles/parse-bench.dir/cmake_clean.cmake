@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/parse-bench"
+  "../bin/parse-bench.pdb"
+  "CMakeFiles/parse-bench.dir/parse_bench.cpp.o"
+  "CMakeFiles/parse-bench.dir/parse_bench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/parse-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
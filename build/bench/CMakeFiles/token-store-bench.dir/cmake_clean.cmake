@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/token-store-bench"
+  "../bin/token-store-bench.pdb"
+  "CMakeFiles/token-store-bench.dir/token_store_bench.cpp.o"
+  "CMakeFiles/token-store-bench.dir/token_store_bench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/token-store-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/AST/ASTGeneration.cpp" "src/AST/CMakeFiles/AST.dir/ASTGeneration.cpp.o" "gcc" "src/AST/CMakeFiles/AST.dir/ASTGeneration.cpp.o.d"
+  "/root/repo/src/AST/AbstractSyntaxTree.cpp" "src/AST/CMakeFiles/AST.dir/AbstractSyntaxTree.cpp.o" "gcc" "src/AST/CMakeFiles/AST.dir/AbstractSyntaxTree.cpp.o.d"
+  "/root/repo/src/AST/ParseTreeVisitor.cpp" "src/AST/CMakeFiles/AST.dir/ParseTreeVisitor.cpp.o" "gcc" "src/AST/CMakeFiles/AST.dir/ParseTreeVisitor.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/build/src/parser/CMakeFiles/Parser.dir/DependInfo.cmake"
+  "/root/repo/build/src/visitor/CMakeFiles/Visitor.dir/DependInfo.cmake"
+  "/root/repo/build/src/lexer/CMakeFiles/Lexer.dir/DependInfo.cmake"
+  "/root/repo/build/src/token/CMakeFiles/Token.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../lib/libAST.a"
+  "../../lib/libAST.pdb"
+  "CMakeFiles/AST.dir/ASTGeneration.cpp.o"
+  "CMakeFiles/AST.dir/ASTGeneration.cpp.o.d"
+  "CMakeFiles/AST.dir/AbstractSyntaxTree.cpp.o"
+  "CMakeFiles/AST.dir/AbstractSyntaxTree.cpp.o.d"
+  "CMakeFiles/AST.dir/ParseTreeVisitor.cpp.o"
+  "CMakeFiles/AST.dir/ParseTreeVisitor.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/AST.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/decaf-22"
+  "../bin/decaf-22.pdb"
+  "CMakeFiles/decaf-22.dir/main.cpp.o"
+  "CMakeFiles/decaf-22.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decaf-22.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
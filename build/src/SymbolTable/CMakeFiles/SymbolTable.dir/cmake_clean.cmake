@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../lib/libSymbolTable.a"
+  "../../lib/libSymbolTable.pdb"
+  "CMakeFiles/SymbolTable.dir/SymbolTableVisitor.cpp.o"
+  "CMakeFiles/SymbolTable.dir/SymbolTableVisitor.cpp.o.d"
+  "CMakeFiles/SymbolTable.dir/generate.cpp.o"
+  "CMakeFiles/SymbolTable.dir/generate.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SymbolTable.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
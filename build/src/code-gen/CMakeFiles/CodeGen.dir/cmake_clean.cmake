@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libCodeGen.a"
+  "../../lib/libCodeGen.pdb"
+  "CMakeFiles/CodeGen.dir/CodeGenVisitor.cpp.o"
+  "CMakeFiles/CodeGen.dir/CodeGenVisitor.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CodeGen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libdecaf.a"
+  "../../lib/libdecaf.pdb"
+  "CMakeFiles/Decaf.dir/compile.cpp.o"
+  "CMakeFiles/Decaf.dir/compile.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Decaf.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/lexer/lexer.cpp" "src/lexer/CMakeFiles/Lexer.dir/lexer.cpp.o" "gcc" "src/lexer/CMakeFiles/Lexer.dir/lexer.cpp.o.d"
+  "/root/repo/src/lexer/scan.cpp" "src/lexer/CMakeFiles/Lexer.dir/scan.cpp.o" "gcc" "src/lexer/CMakeFiles/Lexer.dir/scan.cpp.o.d"
+  "/root/repo/src/lexer/source.cpp" "src/lexer/CMakeFiles/Lexer.dir/source.cpp.o" "gcc" "src/lexer/CMakeFiles/Lexer.dir/source.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/build/src/token/CMakeFiles/Token.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
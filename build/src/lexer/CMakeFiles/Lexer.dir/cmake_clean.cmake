@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../lib/libLexer.a"
+  "../../lib/libLexer.pdb"
+  "CMakeFiles/Lexer.dir/lexer.cpp.o"
+  "CMakeFiles/Lexer.dir/lexer.cpp.o.d"
+  "CMakeFiles/Lexer.dir/scan.cpp.o"
+  "CMakeFiles/Lexer.dir/scan.cpp.o.d"
+  "CMakeFiles/Lexer.dir/source.cpp.o"
+  "CMakeFiles/Lexer.dir/source.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Lexer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
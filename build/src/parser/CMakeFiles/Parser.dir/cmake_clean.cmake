@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../lib/libParser.a"
+  "../../lib/libParser.pdb"
+  "CMakeFiles/Parser.dir/ParseTree.cpp.o"
+  "CMakeFiles/Parser.dir/ParseTree.cpp.o.d"
+  "CMakeFiles/Parser.dir/ParseTreePrinter.cpp.o"
+  "CMakeFiles/Parser.dir/ParseTreePrinter.cpp.o.d"
+  "CMakeFiles/Parser.dir/TreeGeneration.cpp.o"
+  "CMakeFiles/Parser.dir/TreeGeneration.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libSemanticAnalyzer.a"
+  "../../lib/libSemanticAnalyzer.pdb"
+  "CMakeFiles/SemanticAnalyzer.dir/STTypeVisitor.cpp.o"
+  "CMakeFiles/SemanticAnalyzer.dir/STTypeVisitor.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SemanticAnalyzer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
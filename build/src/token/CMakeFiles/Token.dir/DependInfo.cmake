@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/token/symbols.cpp" "src/token/CMakeFiles/Token.dir/symbols.cpp.o" "gcc" "src/token/CMakeFiles/Token.dir/symbols.cpp.o.d"
+  "/root/repo/src/token/token.cpp" "src/token/CMakeFiles/Token.dir/token.cpp.o" "gcc" "src/token/CMakeFiles/Token.dir/token.cpp.o.d"
+  "/root/repo/src/token/writer.cpp" "src/token/CMakeFiles/Token.dir/writer.cpp.o" "gcc" "src/token/CMakeFiles/Token.dir/writer.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
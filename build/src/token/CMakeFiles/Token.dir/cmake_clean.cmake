@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../lib/libToken.a"
+  "../../lib/libToken.pdb"
+  "CMakeFiles/Token.dir/symbols.cpp.o"
+  "CMakeFiles/Token.dir/symbols.cpp.o.d"
+  "CMakeFiles/Token.dir/token.cpp.o"
+  "CMakeFiles/Token.dir/token.cpp.o.d"
+  "CMakeFiles/Token.dir/writer.cpp.o"
+  "CMakeFiles/Token.dir/writer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Token.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
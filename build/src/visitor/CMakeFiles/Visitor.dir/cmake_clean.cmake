@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libVisitor.a"
+  "../../lib/libVisitor.pdb"
+  "CMakeFiles/Visitor.dir/parseVisitor.cpp.o"
+  "CMakeFiles/Visitor.dir/parseVisitor.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Visitor.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/compile_test.cpp" "tests/CMakeFiles/compile-test.dir/compile_test.cpp.o" "gcc" "tests/CMakeFiles/compile-test.dir/compile_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/build/src/decaf/CMakeFiles/Decaf.dir/DependInfo.cmake"
+  "/root/repo/build/src/SymbolTable/CMakeFiles/SymbolTable.dir/DependInfo.cmake"
+  "/root/repo/build/src/semantic-analyzer/CMakeFiles/SemanticAnalyzer.dir/DependInfo.cmake"
+  "/root/repo/build/src/code-gen/CMakeFiles/CodeGen.dir/DependInfo.cmake"
+  "/root/repo/build/src/AST/CMakeFiles/AST.dir/DependInfo.cmake"
+  "/root/repo/build/src/parser/CMakeFiles/Parser.dir/DependInfo.cmake"
+  "/root/repo/build/src/lexer/CMakeFiles/Lexer.dir/DependInfo.cmake"
+  "/root/repo/build/src/token/CMakeFiles/Token.dir/DependInfo.cmake"
+  "/root/repo/build/src/visitor/CMakeFiles/Visitor.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
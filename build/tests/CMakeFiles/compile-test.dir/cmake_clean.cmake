@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/compile-test"
+  "../bin/compile-test.pdb"
+  "CMakeFiles/compile-test.dir/compile_test.cpp.o"
+  "CMakeFiles/compile-test.dir/compile_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/compile-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
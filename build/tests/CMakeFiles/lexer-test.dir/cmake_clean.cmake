@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/lexer-test"
+  "../bin/lexer-test.pdb"
+  "CMakeFiles/lexer-test.dir/lexer_test.cpp.o"
+  "CMakeFiles/lexer-test.dir/lexer_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/lexer-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/parser-test"
+  "../bin/parser-test.pdb"
+  "CMakeFiles/parser-test.dir/parser_test.cpp.o"
+  "CMakeFiles/parser-test.dir/parser_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/parser-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
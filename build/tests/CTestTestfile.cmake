@@ -0,0 +1,64 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_invalid_file "/root/repo/build/bin/lexer-test" "bad_file")
+set_tests_properties(test_invalid_file PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;27;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_valid_file "/root/repo/build/bin/lexer-test" "good_file")
+set_tests_properties(test_valid_file PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_working_files "/root/repo/build/bin/lexer-test" "good_files")
+set_tests_properties(test_working_files PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;43;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_empty_file "/root/repo/build/bin/lexer-test" "empty_file")
+set_tests_properties(test_empty_file PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;52;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_token_views "/root/repo/build/bin/lexer-test" "token_views")
+set_tests_properties(test_token_views PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;61;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_reserved_lookup "/root/repo/build/bin/lexer-test" "reserved_lookup")
+set_tests_properties(test_reserved_lookup PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;70;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_symbol_interning "/root/repo/build/bin/lexer-test" "symbol_interning")
+set_tests_properties(test_symbol_interning PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;77;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_tokenize_all "/root/repo/build/bin/lexer-test" "tokenize_all")
+set_tests_properties(test_tokenize_all PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;86;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_scan_kernels "/root/repo/build/bin/lexer-test" "scan_kernels")
+set_tests_properties(test_scan_kernels PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;95;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_parallel_lexing "/root/repo/build/bin/lexer-test" "parallel_lexing")
+set_tests_properties(test_parallel_lexing PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;102;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_numeric_literals "/root/repo/build/bin/lexer-test" "numeric_literals")
+set_tests_properties(test_numeric_literals PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;111;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_pipe_source "/root/repo/build/bin/lexer-test" "pipe_source")
+set_tests_properties(test_pipe_source PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;120;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_expression_parsing "/root/repo/build/bin/parser-test" "expression_parsing")
+set_tests_properties(test_expression_parsing PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;129;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_concurrent_parse "/root/repo/build/bin/parser-test" "concurrent_parse")
+set_tests_properties(test_concurrent_parse PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;136;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_ast_generation "/root/repo/build/bin/parser-test" "ast_generation")
+set_tests_properties(test_ast_generation PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;145;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_compile_repeatable "/root/repo/build/bin/compile-test" "compile_repeatable")
+set_tests_properties(test_compile_repeatable PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;154;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_compile_diagnostics "/root/repo/build/bin/compile-test" "compile_diagnostics")
+set_tests_properties(test_compile_diagnostics PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;163;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_arena_release "/root/repo/build/bin/compile-test" "arena_release")
+set_tests_properties(test_arena_release PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;172;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_lexer_outputs "/usr/bin/bash" "/root/repo/tests/test-output.sh" "/root/repo" "lexer" "--lexer")
+set_tests_properties(test_lexer_outputs PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;181;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_parser_outputs "/usr/bin/bash" "/root/repo/tests/test-output.sh" "/root/repo" "parser" "--parser")
+set_tests_properties(test_parser_outputs PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;190;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_semantic_analyzer_outputs "/usr/bin/bash" "/root/repo/tests/test-output.sh" "/root/repo" "semantic" "--semantic-check")
+set_tests_properties(test_semantic_analyzer_outputs PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;199;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_code_generation_outputs "/usr/bin/bash" "/root/repo/tests/test-output.sh" "/root/repo" "codegen" "--code-gen")
+set_tests_properties(test_code_generation_outputs PROPERTIES  WORKING_DIRECTORY "/root/repo/tests/assembly-test" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;208;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_syntax_only "/root/repo/build/bin/parser-test" "syntax_only")
+set_tests_properties(test_syntax_only PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;217;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_error_recovery "/root/repo/build/bin/parser-test" "error_recovery")
+set_tests_properties(test_error_recovery PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;226;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_tree_printer "/root/repo/build/bin/parser-test" "tree_printer")
+set_tests_properties(test_tree_printer PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;235;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_parallel_parse "/root/repo/build/bin/parser-test" "parallel_parse")
+set_tests_properties(test_parallel_parse PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;244;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_lazy_bodies "/root/repo/build/bin/parser-test" "lazy_bodies")
+set_tests_properties(test_lazy_bodies PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;253;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_compile_signatures "/root/repo/build/bin/compile-test" "compile_signatures")
+set_tests_properties(test_compile_signatures PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;262;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_node_kinds "/root/repo/build/bin/parser-test" "node_kinds")
+set_tests_properties(test_node_kinds PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;271;add_test;/root/repo/tests/CMakeLists.txt;0;")
@@ -0,0 +1,73 @@
+#include <parser/Grammar.hpp>
+#include <parser/ParserContext.hpp>
+
+#include "ASTGeneration.hpp"
+
+namespace AST
+{
+    Program* astGeneration(Scanner::Lexer *lexer, Common::Arena &arena, std::vector<Parser::ParseException> *errors)
+    {
+        Parser::ParserContext context(lexer, errors);
+        TreeBuilder builder(arena);
+
+        // Setup look ahead for certain parsing calls
+        context.addLookAhead();
+        return Parser::parseProgram(context, builder);
+    }
+
+    Program* parallelAstGeneration(Scanner::Lexer *lexer, Common::Arena &arena, unsigned numThreads)
+    {
+        TreeBuilder builder(arena);
+
+        return Parser::parseConcurrently(lexer, builder, arena,
+                                         [](Common::Arena &local) { return TreeBuilder(local); }, numThreads);
+    }
+
+    Program* signatureGeneration(Scanner::Lexer *lexer, Common::Arena &arena)
+    {
+        const Scanner::TokenStore &tokens = lexer->tokenizeAll();
+        Parser::ParserContext context(tokens, 0, tokens.size());
+        TreeBuilder builder(arena);
+        std::vector<Parser::DeferredBody<TreeBuilder>> bodies;
+
+        Program *program = nullptr;
+
+        try {
+            context.addLookAhead();
+            program = Parser::parseProgram(context, builder, &bodies);
+        }
+        catch (...)
+        {
+            // keep only the lexer messages a parse reading from the lexer
+            // would have had by the time it stopped
+            lexer->dropDiagnostics(context.numRead());
+            throw;
+        }
+
+        for (Parser::DeferredBody<TreeBuilder> &body : bodies)
+            body.function->lazy = arena.make<LazyBody>(LazyBody{&tokens, body.begin, body.end, &arena});
+
+        return program;
+    }
+
+    StatementBlock* FunctionDeclaration::body()
+    {
+        if (lazy == nullptr)
+            return stmts;
+
+        Parser::ParserContext context(*lazy->tokens, lazy->begin, lazy->end);
+        TreeBuilder builder(*lazy->arena);
+
+        context.addLookAhead();
+        StatementBlock *block = Parser::parseStmtBlock(context, builder);
+
+        // the block has to take the whole range
+        if (block == nullptr || context.peek(0).type() != Scanner::Token::Type::END)
+            throw Parser::ParseException(context.peek(0));
+
+        stmts = block;
+        lazy = nullptr;
+
+        return stmts;
+    }
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "AbstractSyntaxTree.hpp"
+
+#include <common/Arena.hpp>
+#include <lexer/lexer.hpp>
+#include <parser/exceptions.hpp>
+
+namespace AST {
+    /**
+     * @brief Makes the AST nodes for the parser grammar (parser/Grammar.hpp)
+     *
+     *  Used by the grammar to parse straight to an AST and by
+     *  ParseTreeConverter to make the same nodes from a parse tree.
+     */
+    class TreeBuilder {
+        public:
+            TreeBuilder(Common::Arena &arena)
+                : arena(arena)
+            {};
+
+            using Expression = Node*;
+            using Statement = Node*;
+            using Call = AST::Call*;
+            using Block = StatementBlock*;
+            using Function = FunctionDeclaration*;
+            using Program = AST::Program*;
+
+            Expression lvalue(Scanner::Token ident) { return arena.make<Ident>(ident); }
+            Expression constant(Scanner::Token token) { return arena.make<Constant>(token); }
+
+            Call call(Scanner::Token ident, Scanner::Token /* lparen */)
+            {
+                AST::Call *call;
+
+                if (ident.symbol() == Scanner::Symbols::Print)
+                    call = arena.make<Print>();
+                else if (ident.symbol() == Scanner::Symbols::ReadInteger)
+                    call = arena.make<ReadInteger>();
+                else if (ident.symbol() == Scanner::Symbols::ReadLine)
+                    call = arena.make<ReadLine>();
+                else
+                    call = arena.make<AST::Call>();
+
+                call->value = ident;
+                return call;
+            }
+
+            void addActual(Call call, Expression expr) { call->actuals.push_back(expr); }
+            Expression closeCall(Call call, Scanner::Token /* rparen */) { return call; }
+
+            // parentheses only group, there is no node for them
+            Expression paren(Scanner::Token /* lparen */, Expression expr, Scanner::Token /* rparen */) { return expr; }
+
+            Expression unary(Scanner::Token op, Expression expr)
+            {
+                Expr *unary;
+
+                // only prefix operators come here, so - is negation
+                switch(op.subType())
+                {
+                    case Scanner::Token::SubType::Subtract:         unary = arena.make<Subtract>(); break;
+                    case Scanner::Token::SubType::Not:              unary = arena.make<Not>();      break;
+                    default:
+                        throw Parser::ParseException(op);
+                }
+
+                unary->op = op;
+                unary->left = expr;
+                return unary;
+            }
+
+            Expression binary(Scanner::Token op, Expression left, Expression right)
+            {
+                Expr *binary;
+
+                switch(op.subType())
+                {
+                    case Scanner::Token::SubType::Assign:       binary = arena.make<Assign>();      break;
+                    case Scanner::Token::SubType::And:          binary = arena.make<And>();         break;
+                    case Scanner::Token::SubType::Or:           binary = arena.make<Or>();          break;
+                    case Scanner::Token::SubType::Equal:        binary = arena.make<Equal>();       break;
+                    case Scanner::Token::SubType::NotEqual:     binary = arena.make<NotEqual>();    break;
+                    case Scanner::Token::SubType::LessThan:     binary = arena.make<LessThan>();    break;
+                    case Scanner::Token::SubType::LessEqual:    binary = arena.make<LTE>();         break;
+                    case Scanner::Token::SubType::GreaterThan:  binary = arena.make<GreaterThan>(); break;
+                    case Scanner::Token::SubType::GreaterEqual: binary = arena.make<GTE>();         break;
+                    case Scanner::Token::SubType::Add:          binary = arena.make<Add>();         break;
+                    case Scanner::Token::SubType::Subtract:     binary = arena.make<Subtract>();    break;
+                    case Scanner::Token::SubType::Multiply:     binary = arena.make<Multiply>();    break;
+                    case Scanner::Token::SubType::Divide:       binary = arena.make<Divide>();      break;
+                    case Scanner::Token::SubType::Modulus:      binary = arena.make<Modulus>();     break;
+                    default:
+                        throw Parser::ParseException(op);
+                }
+
+                binary->op = op;
+                binary->left = left;
+                binary->right = right;
+                return binary;
+            }
+
+            Statement expressionStmt(Expression expr, Scanner::Token /* semiColon */) { return expr; }
+
+            Statement whileStmt(Scanner::Token keyword, Scanner::Token /* lparen */, Expression expr,
+                                Scanner::Token /* rparen */, Statement stmt)
+            {
+                return setLoop(arena.make<While>(), keyword, expr, stmt);
+            }
+
+            Statement ifStmt(Scanner::Token keyword, Scanner::Token /* lparen */, Expression expr,
+                             Scanner::Token /* rparen */, Statement stmt, Scanner::Token /* elseKeyword */, Statement elseStmt)
+            {
+                If *ifStmt = setLoop(arena.make<If>(), keyword, expr, stmt);
+                ifStmt->elseStmt = elseStmt;
+                return ifStmt;
+            }
+
+            Statement forStmt(Scanner::Token keyword, Scanner::Token /* lparen */, Expression startExpr,
+                              Scanner::Token /* endStart */, Expression expr, Scanner::Token /* endExpr */,
+                              Expression loopExpr, Scanner::Token /* rparen */, Statement stmt)
+            {
+                For *forStmt = setLoop(arena.make<For>(), keyword, expr, stmt);
+                forStmt->startExpr = startExpr;
+                forStmt->loopExpr = loopExpr;
+                return forStmt;
+            }
+
+            Statement breakStmt(Scanner::Token keyword, Scanner::Token /* semiColon */)
+            {
+                Break *breakStmt = arena.make<Break>();
+                breakStmt->value = keyword;
+                return breakStmt;
+            }
+
+            Statement returnStmt(Scanner::Token keyword, Expression expr, Scanner::Token /* semiColon */)
+            {
+                Return *ret = arena.make<Return>();
+                ret->value = keyword;
+                ret->expr = expr;
+                return ret;
+            }
+
+            Block block(Scanner::Token /* lbrace */) { return arena.make<StatementBlock>(); }
+
+            void addVariable(Block block, Scanner::Token type, Scanner::Token ident, Scanner::Token /* semiColon */)
+            {
+                block->decls.push_back(declaration(arena.make<Declaration>(), type, ident));
+            }
+
+            void addStatement(Block block, Statement stmt) { block->stmts.push_back(stmt); }
+            Block closeBlock(Block block, Scanner::Token /* rbrace */) { return block; }
+
+            Function function(Scanner::Token type, Scanner::Token ident, Scanner::Token /* lparen */)
+            {
+                return declaration(arena.make<FunctionDeclaration>(), type, ident);
+            }
+
+            void addFormal(Function func, Scanner::Token type, Scanner::Token ident, Scanner::Token /* comma */)
+            {
+                func->formals.push_back(declaration(arena.make<Declaration>(), type, ident));
+            }
+
+            void closeFunction(Function func, Scanner::Token /* rparen */, Block block) { func->stmts = block; }
+
+            Program program() { return arena.make<AST::Program>(); }
+
+            void addVariable(Program program, Scanner::Token type, Scanner::Token ident, Scanner::Token /* semiColon */)
+            {
+                program->vars.push_back(declaration(arena.make<Declaration>(), type, ident));
+            }
+
+            void addFunction(Program program, Function func) { program->func.push_back(func); }
+
+        private:
+            Common::Arena &arena;
+
+            template <class Decl>
+            Decl* declaration(Decl *decl, Scanner::Token type, Scanner::Token ident)
+            {
+                decl->type = type.type();
+                decl->ident = ident;
+                return decl;
+            }
+
+            template <class Loop>
+            Loop* setLoop(Loop *loop, Scanner::Token keyword, Expression expr, Statement stmt)
+            {
+                loop->value = keyword;
+                loop->expr = expr;
+                loop->stmt = stmt;
+                return loop;
+            }
+    };
+
+
+    /**
+     * @brief Parse the token stream of lexer straight into an AST
+     *
+     *  Runs the same grammar as Parser::treeGeneration but makes AST nodes
+     *  as it goes instead of a parse tree to convert afterwards, so the
+     *  passes after parsing get the same tree for half the allocations.
+     *  Errors are thrown, or recovered from into errors, exactly as
+     *  Parser::treeGeneration does.
+     *
+     * @param lexer
+     * @param arena the nodes are made in, the tree lives as long as it does
+     * @param errors where syntax errors are kept, null to throw the first
+     */
+    Program* astGeneration(Scanner::Lexer *lexer, Common::Arena &arena,
+                           std::vector<Parser::ParseException> *errors=nullptr);
+
+    /**
+     * @brief astGeneration with function bodies parsed on numThreads threads
+     *
+     *  Same AST and errors as astGeneration, see Parser::parallelTreeGeneration.
+     */
+    Program* parallelAstGeneration(Scanner::Lexer *lexer, Common::Arena &arena, unsigned numThreads);
+
+    // tokens [begin, end) of tokens, the body's nodes are made in arena
+    struct LazyBody {
+        const Scanner::TokenStore *tokens;
+        std::uint32_t       begin;
+        std::uint32_t       end;
+        Common::Arena       *arena;
+    };
+
+    /**
+     * @brief Parse only the declarations of the file lexer reads
+     *
+     *  The file is lexed in full, then global variables and function
+     *  signatures are parsed and each function body is stepped over by
+     *  matching its braces. A body is parsed the first time
+     *  FunctionDeclaration::body() is called for it, so passes that only
+     *  need the global symbol table never pay for the bodies and ones that
+     *  visit them get the tree astGeneration makes.
+     *
+     *  Lexical errors anywhere and syntax errors outside the bodies are
+     *  thrown as astGeneration throws them, syntax errors inside a body when
+     *  it is parsed. The lexer keeps the tokens, it has to outlive the tree.
+     *
+     * @param lexer
+     * @param arena the nodes are made in, the tree lives as long as it does
+     */
+    Program* signatureGeneration(Scanner::Lexer *lexer, Common::Arena &arena);
+};
@@ -1,9 +1,6 @@
 #include <iostream>
 
-#include <parser/exceptions.hpp>
-
 #include "AbstractSyntaxTree.hpp"
-#include "ParseTreeVisitor.hpp"
 
 
 
@@ -11,263 +8,11 @@ namespace AST
 {
     // Constructors
     Modulus::Modulus()
-        : Expr()
+        : Expr(Kind::Modulus)
     {};
             
-    Modulus::Modulus(Parser::ArithmeticExpression *expr)
-        : Expr(expr)
-    {
-        // std::cout << "Modulus: Generating expr\n";
-    };
-
     void Modulus::accept(Visitor *v) { v->visit(this); };
 
-    KeywordStmt::KeywordStmt(Parser::KeywordStmt *stmt)
-        : Value(stmt->keyword)
-        , expr(nullptr)
-    {
-        if (stmt->expr != nullptr)
-        {
-            ParseTreeConverter visitor = ParseTreeConverter();
-            stmt->expr->accept(&visitor);
-            expr = visitor.pNode;
-            if (visitor.pNode == nullptr)
-                throw Parser::ParseException( stmt->firstToken() );
-        }
-    }
-
-    While::While(Parser::WhileStmt *stmt)
-        : KeywordStmt(stmt)
-        , stmt(nullptr)
-    {
-        // std::cout << "While: getting start expr\n";
-        ParseTreeConverter visitor = ParseTreeConverter();
-
-        // std::cout << "While: getting statement\n";
-        stmt->stmt->accept(&visitor);
-        this->stmt = visitor.pNode;
-
-        if (visitor.pNode == nullptr)
-            throw Parser::ParseException( stmt->firstToken() );
-    };
-
-    If::If(Parser::IfStmt *stmt)
-        : While(stmt)
-        , elseStmt(nullptr)
-    {
-        // std::cout << "If: getting start expr\n";
-        if ( stmt->elseBlock != nullptr )
-        {
-            ParseTreeConverter visitor = ParseTreeConverter();
-
-            stmt->elseBlock->accept(&visitor);
-            elseStmt = visitor.pNode;
-
-            if (visitor.pNode == nullptr)
-                throw Parser::ParseException( stmt->firstToken() );
-        }
-    }
-
-    For::For(Parser::ForStmt *stmt)
-        : While(stmt)
-        , startExpr(nullptr)
-        , loopExpr(nullptr)
-    {
-        if (stmt->startExpr != nullptr)
-        {
-            // std::cout << "For: getting start expr\n";
-            ParseTreeConverter visitor = ParseTreeConverter();
-
-            stmt->startExpr->accept(&visitor);
-            startExpr = visitor.pNode;
-
-            if (visitor.pNode == nullptr)
-                throw Parser::ParseException( stmt->firstToken() );
-        }
-
-        if (stmt->loopExpr != nullptr)
-        {
-            // std::cout << "For: getting loop expr\n";
-            ParseTreeConverter visitor = ParseTreeConverter();
-
-            stmt->loopExpr->accept(&visitor);
-            loopExpr = visitor.pNode;
-
-            if (visitor.pNode == nullptr)
-                throw Parser::ParseException( stmt->firstToken() );
-        }
-    }
-
-    Call::Call(Parser::CallExpression *c)
-        : Value(c->ident->ident)
-    {
-        // std::cout << "Call: Generating call with identifier " << value.getValue<std::string>() << std::endl;
-
-        for ( auto &var : c->actuals )
-        {
-            ParseTreeConverter visitor = ParseTreeConverter();
-
-            var->accept(&visitor);
-            actuals.push_back(visitor.pNode);
-
-            if (visitor.pNode == nullptr)
-                throw Parser::ParseException( c->firstToken() );
-        }
-    }
-
-    Expr::Expr(Parser::Expression *expr)
-        : Node()
-        , left(nullptr)
-        , op(Scanner::Token::Type::EMPTY)
-        , right(nullptr)
-    {
-        if (expr->expr != nullptr )
-        {
-            ParseTreeConverter visitor = ParseTreeConverter();
-            expr->expr->accept(&visitor);
-            left = visitor.pNode;
-
-            if (visitor.pNode == nullptr)
-                throw Parser::ParseException( expr->firstToken() );
-        }
-    }
-
-    Expr::Expr(Parser::UnaryExpression *expr)
-        : Node()
-        , left(nullptr)
-        , op(expr->op)
-        , right(nullptr)
-    {
-        if (expr->expr != nullptr )
-        {
-            ParseTreeConverter visitor = ParseTreeConverter();
-            expr->expr->accept(&visitor);
-            left = visitor.pNode;
-
-            if (visitor.pNode == nullptr)
-                throw Parser::ParseException( expr->firstToken() );
-        }
-    }
-
-    Expr::Expr(Parser::BinaryExpression *expr)
-        : Node()
-        , left(nullptr)
-        , op(Scanner::Token::Type::EMPTY)
-        , right(nullptr)
-    {
-        op = expr->op;
-        
-        ParseTreeConverter visitor = ParseTreeConverter();
-        if (expr->expr != nullptr )
-        {
-            expr->expr->accept(&visitor);
-            left = visitor.pNode;
-
-            if (visitor.pNode == nullptr)
-                throw Parser::ParseException( expr->expr->firstToken() );
-            visitor.pNode = nullptr;
-        }
-
-        if ( expr->right != nullptr )
-        {
-            expr->right->accept(&visitor);
-            right = visitor.pNode;
-            if (visitor.pNode == nullptr)
-                throw Parser::ParseException( expr->right->firstToken() );
-            visitor.pNode = nullptr;
-        }
-    }
-
-    Return::Return(Parser::ReturnStmt *stmt)
-        : KeywordStmt(stmt)
-    {
-        
-        if ( stmt->expr != nullptr )
-        {
-            // std::cout << "Return: Getting expr\n";
-            // expr = new Expr
-            ParseTreeConverter visitor = ParseTreeConverter();
-
-            stmt->expr->accept(&visitor);
-            Node *pNode(visitor.pNode);
-
-            if ( pNode == nullptr )
-                throw Parser::ParseException( stmt->firstToken() );
-
-            expr = pNode;
-        }
-        // else
-            // std::cout << "Return: \n";
-    }
-
-    StatementBlock::StatementBlock(Parser::StatementBlock *block)
-        : Node()
-        , decls()
-        , stmts()
-    {
-        for (auto &decl : block->vars)
-        {
-            decls.push_back(new Declaration(decl));
-        }
-
-        int vars( decls.size() );
-
-        for( auto &stmt: block->stmts )
-        {
-            ParseTreeConverter visitor = ParseTreeConverter();
-            // visit node and covnert
-            stmt->accept(&visitor);
-            Node *pNode( visitor.pNode );
-
-            if (pNode != nullptr)
-            {
-                stmts.push_back(pNode);
-            }
-            else
-                throw Parser::ParseException( stmt->firstToken() );
-        }
-
-    }
-
-    FunctionDeclaration::FunctionDeclaration(Parser::FunctionDeclaration *func)
-                : Declaration(func)
-                , formals()
-                , stmts(nullptr)
-    {
-        for( auto &decl : func->formals)
-        {
-            formals.push_back(new Declaration(decl));
-        }
-        stmts = new StatementBlock(func->block);
-    };
-
-    Program::Program(Parser::Program *p)
-        : Node()
-        , vars()
-        , func()
-    {
-        for(auto &decl : p->decls)
-        {
-
-            if (dynamic_cast<Parser::VariableDeclaration*>(decl) != nullptr)
-            {
-                vars.push_back(new Declaration(decl));
-            } 
-            else 
-            {
-                ParseTreeConverter converter = ParseTreeConverter();
-                decl->accept(&converter);
-                func.push_back(converter.pNode);
-
-                if (converter.pNode == nullptr)
-                    throw Parser::ParseException( decl->firstToken() );
-            }
-
-        }
-
-        return;
-    }
-
 
     // SetScope to children nodes
 
@@ -10,19 +10,64 @@
 
 #include <code-gen/Entities.hpp>
 
+#include <common/Casting.hpp>
+
 namespace AST {
 
     /**
      *      Generic Syntax Tree Objects
      */
     class Node : public Acceptor {
+        public:
+            /**
+             * @brief What the node is, for Common::isa / dyn_cast
+             *
+             *  A class and the classes derived from it are one run of kinds,
+             *  first the class itself, so classof checks a range.
+             */
+            enum class Kind {
+                Declaration,
+                FunctionDeclaration,
+                StatementBlock,
+                Ident,
+                Constant,
+                Call,
+                Print,
+                ReadInteger,
+                ReadLine,
+                Break,
+                Return,
+                While,
+                If,
+                For,
+                Add,
+                Subtract,
+                Multiply,
+                Divide,
+                Modulus,
+                LessThan,
+                LTE,
+                GreaterThan,
+                GTE,
+                Equal,
+                NotEqual,
+                And,
+                Or,
+                Not,
+                Assign,
+                Program
+            };
+
         protected:            
-            Node() 
+            Node(Kind kind) 
                 : pScope(nullptr)
                 , reg(nullptr)
+                , nodeKind(kind)
             {};
             
         public:
+            Kind kind() const { return nodeKind; };
+
             // future meta information for symbol table, return type (function/expr), etc.
 
             // Each node holds a ref to their closest scope, each scope holds a ref to their
@@ -59,47 +104,54 @@ namespace AST {
              * @return int 
              */
             virtual int maxCol() = 0;
-            
+
+        private:
+            Kind nodeKind;
     };
 
     // represents either identifier or constant
     class Value: public Node
     {
-        public:
-            Value()
-                : Node()
+        protected:
+            Value(Kind kind)
+                : Node(kind)
                 , value()
                 {};
 
-            Value(Scanner::Token token)
-                : Node()
+            Value(Kind kind, Scanner::Token token)
+                : Node(kind)
                 , value(token)
             {};
             
+        public:
             Scanner::Token              value;
 
+            static bool classof(const Node *node) { return node->kind() >= Kind::Ident && node->kind() <= Kind::For; };
+
             virtual void setScope(SymbolTable::Scope *p) { pScope = p; };
 
             // helper functions for min max columen info
-            virtual int minCol() { return value.colStart; };
-            virtual int maxCol() { return value.colStart + value.getValue<std::string>().length(); };
+            virtual int minCol() { return value.colStart(); };
+            virtual int maxCol() { return value.colStart() + value.getValue<std::string>().length(); };
     };
 
     class Declaration: public Node
     {
         public:
             Declaration()
-                : Node()
+                : Declaration(Kind::Declaration)
+                {};
+
+            static bool classof(const Node *node) { return node->kind() >= Kind::Declaration && node->kind() <= Kind::FunctionDeclaration; };
+
+        protected:
+            Declaration(Kind kind)
+                : Node(kind)
                 , type()
                 , ident()
                 {};
 
-            Declaration(Parser::Declarations *decl)
-                : Node()
-                , type(decl->type->type.type)
-                , ident(decl->ident->ident)
-            {};
-
+        public:
             virtual void accept(Visitor *v) { v->visit(this); };
             
             Scanner::Token::Type        type;
@@ -107,8 +159,8 @@ namespace AST {
 
             void setScope(SymbolTable::Scope *p) { pScope = p; };
 
-            virtual int minCol() { return ident.colStart; };
-            virtual int maxCol() { return ident.colStart + ident.getValue<std::string>().length(); };
+            virtual int minCol() { return ident.colStart(); };
+            virtual int maxCol() { return ident.colStart() + ident.getValue<std::string>().length(); };
     };
 
     /**
@@ -123,12 +175,13 @@ namespace AST {
     {
         public:
             StatementBlock()
-                : Node()
+                : Node(Kind::StatementBlock)
                 , decls()
                 , stmts()
                 {};
 
-            StatementBlock(Parser::StatementBlock *block);
+            static bool classof(const Node *node) { return node->kind() == Kind::StatementBlock; };
+
             void accept(Visitor *v) { v->visit(this); };
             
             // is this even needed? parsing already ensured that decls are at the front
@@ -140,16 +193,21 @@ namespace AST {
             int minCol() { return decls.front()->minCol(); };
             int maxCol() { return stmts.back()->maxCol();  };
     };
+    // tokens of a function body not parsed yet, see signatureGeneration
+    struct LazyBody;
+
     class FunctionDeclaration: public Declaration
     {
         public:
             FunctionDeclaration()
-                : Declaration()
+                : Declaration(Kind::FunctionDeclaration)
                 , formals()
                 , stmts(nullptr)
+                , lazy(nullptr)
                 {};
 
-            FunctionDeclaration(Parser::FunctionDeclaration *func);
+            static bool classof(const Node *node) { return node->kind() == Kind::FunctionDeclaration; };
+
             void accept(Visitor *v) 
             { 
                 // std::cout << "Function accepting visitor: "; 
@@ -157,7 +215,18 @@ namespace AST {
             };
             
             std::vector<Declaration*>   formals;
-            StatementBlock*             stmts;
+            StatementBlock*             stmts;      // null while the body is lazy
+
+            // body left as tokens by signatureGeneration, null once parsed
+            LazyBody*                   lazy;
+
+            /**
+             * @brief The body, parsed from its tokens the first time it is asked for
+             *
+             *  Syntax errors in a lazy body are thrown from here. Not safe to
+             *  call for the same function from two threads at once.
+             */
+            StatementBlock* body();
 
             void setScope(SymbolTable::Scope *p);
     };
@@ -166,11 +235,13 @@ namespace AST {
     {
         public:
             Ident(Scanner::Token token)
-                : Value(token)
+                : Value(Kind::Ident, token)
                 {
                     // std::cout << "Identifier: " << token.getValue<std::string>() << std::endl;
                 };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Ident; };
+
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -178,11 +249,13 @@ namespace AST {
     {
         public:
             Constant(Scanner::Token token)
-                : Value(token)
+                : Value(Kind::Constant, token)
                 {
                     // std::cout << "Constant: " << token.getValue<std::string>() << std::endl;
                 };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Constant; };
+
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -190,11 +263,19 @@ namespace AST {
     {
         public:
             Call()
-                : Value()
+                : Call(Kind::Call)
+                {};
+
+            static bool classof(const Node *node) { return node->kind() >= Kind::Call && node->kind() <= Kind::ReadLine; };
+
+        protected:
+            Call(Kind kind)
+                : Value(kind)
                 , actuals()
                 {};
 
-            Call(Parser::CallExpression *c);
+        public:
+
             void accept(Visitor *v) { v->visit(this); };
             
             std::deque<Node*> actuals;
@@ -212,17 +293,16 @@ namespace AST {
 
     class Expr: public Node
     {
-        public:
-            Expr()
-                : Node()
+        protected:
+            Expr(Kind kind)
+                : Node(kind)
                 , left(nullptr)
                 , op(Scanner::Token::Type::EMPTY)
                 , right(nullptr)
                 {};
 
-            Expr(Parser::Expression *expr);
-            Expr(Parser::UnaryExpression *expr);
-            Expr(Parser::BinaryExpression *exp);
+        public:
+            static bool classof(const Node *node) { return node->kind() >= Kind::Add && node->kind() <= Kind::Assign; };
 
             // Binary expressions will have both left and right as non null
             // Unary expressions will have right as non null
@@ -273,13 +353,14 @@ namespace AST {
 
     class KeywordStmt: public Value
     {
-        public:
-            KeywordStmt()
-                : Value()
+        protected:
+            KeywordStmt(Kind kind)
+                : Value(kind)
                 , expr(nullptr)
                 {};
 
-            KeywordStmt(Parser::KeywordStmt *stmt);
+        public:
+            static bool classof(const Node *node) { return node->kind() >= Kind::Break && node->kind() <= Kind::For; };
 
             // for most keywords this will be conditional expression
             // for return this will be return value or null/void
@@ -301,14 +382,10 @@ namespace AST {
     {
         public:
             Add()
-                : Expr()
+                : Expr(Kind::Add)
             {};
 
-            Add(Parser::ArithmeticExpression *expr)
-            : Expr(expr)
-            {
-                // std::cout << "Add: Generating expr\n";
-            };
+            static bool classof(const Node *node) { return node->kind() == Kind::Add; };
 
             void accept(Visitor *v) { v->visit(this); };
     };
@@ -318,23 +395,11 @@ namespace AST {
     {
         public:
             Subtract()
-                : Expr()
+                : Expr(Kind::Subtract)
             {};
-            
-            Subtract(Parser::ArithmeticExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "Subtract: Generating expr\n";
-            };
-
-            Subtract(Parser::UnaryExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "Subtract: Generating unary minus\n";
-                // std::cout << "Left should be non null: " << &left << std::endl;
-                // std::cout << "Right should be null   : " << &right << std::endl;
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Subtract; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -342,15 +407,11 @@ namespace AST {
     {
         public:
             Multiply()
-                : Expr()
+                : Expr(Kind::Multiply)
             {};
-            
-            Multiply(Parser::ArithmeticExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "Multiply: Generating expr\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Multiply; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -358,15 +419,11 @@ namespace AST {
     {
         public:
             Divide()
-                : Expr()
+                : Expr(Kind::Divide)
             {};
-            
-            Divide(Parser::ArithmeticExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "Divide: Generating expr\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Divide; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -374,9 +431,9 @@ namespace AST {
     {
         public:
             Modulus();
-            
-            Modulus(Parser::ArithmeticExpression *expr);
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Modulus; };
+            
             void accept(Visitor *v);
     };
 
@@ -385,15 +442,18 @@ namespace AST {
     {
         public:
             LessThan()
-                : Expr()
+                : LessThan(Kind::LessThan)
                 {};
-            
-            LessThan(Parser::RelationalExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "LessThan: generating\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() >= Kind::LessThan && node->kind() <= Kind::LTE; };
+
+        protected:
+            LessThan(Kind kind)
+                : Expr(kind)
+                {};
+
+        public:
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -401,15 +461,11 @@ namespace AST {
     {
         public:
             LTE()
-                : LessThan()
+                : LessThan(Kind::LTE)
                 {};
-            
-            LTE(Parser::RelationalExpression *expr)
-                : LessThan(expr)
-            {
-                // std::cout << "LessThanEqual: generating\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::LTE; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -417,15 +473,18 @@ namespace AST {
     {
         public:
             GreaterThan()
-                : Expr()
+                : GreaterThan(Kind::GreaterThan)
                 {};
-            
-            GreaterThan(Parser::RelationalExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "GreaterThan: generating\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() >= Kind::GreaterThan && node->kind() <= Kind::GTE; };
+
+        protected:
+            GreaterThan(Kind kind)
+                : Expr(kind)
+                {};
+
+        public:
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -433,15 +492,11 @@ namespace AST {
     {
         public:
             GTE()
-                : GreaterThan()
+                : GreaterThan(Kind::GTE)
                 {};
-            
-            GTE(Parser::RelationalExpression *expr)
-                : GreaterThan(expr)
-            {
-                // std::cout << "GreaterThanEqual: generating\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::GTE; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -449,15 +504,11 @@ namespace AST {
     {
         public:
             Equal()
-                : Expr()
+                : Expr(Kind::Equal)
                 {};
-            
-            Equal(Parser::EqualityExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "Equal: generating\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Equal; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -465,15 +516,11 @@ namespace AST {
     {
         public:
             NotEqual()
-                : Expr()
+                : Expr(Kind::NotEqual)
                 {};
-            
-            NotEqual(Parser::EqualityExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "NotEqual: generating\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::NotEqual; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -481,14 +528,10 @@ namespace AST {
     {
         public:
             And()
-                : Expr()
+                : Expr(Kind::And)
                 {};
-            
-            And(Parser::LogicalExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "And: generating\n";
-            };
+
+            static bool classof(const Node *node) { return node->kind() == Kind::And; };
             
             void accept(Visitor *v) { v->visit(this); };
     };
@@ -497,15 +540,11 @@ namespace AST {
     {
         public:
             Or()
-                : Expr()
+                : Expr(Kind::Or)
                 {};
-            
-            Or(Parser::LogicalExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "Or: generating\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Or; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -513,15 +552,11 @@ namespace AST {
     {
         public:
             Not()
-                : Expr()
+                : Expr(Kind::Not)
                 {};
-            
-            Not(Parser::UnaryExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "Not: Generating expr\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Not; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -529,14 +564,10 @@ namespace AST {
     {
         public:
             Assign()
-                : Expr()
+                : Expr(Kind::Assign)
             {};
 
-            Assign(Parser::AssignExpression *expr)
-                : Expr(expr)
-            {
-                // std::cout << "Assign: Generating expr\n";
-            };
+            static bool classof(const Node *node) { return node->kind() == Kind::Assign; };
 
             void accept(Visitor *v) { v->visit(this); };
     };
@@ -546,10 +577,11 @@ namespace AST {
     {
         public:
             Break()
-                : KeywordStmt()
+                : KeywordStmt(Kind::Break)
                 {};
 
-            Break(Parser::BreakStmt *stmt) : KeywordStmt(stmt) {};
+            static bool classof(const Node *node) { return node->kind() == Kind::Break; };
+
             void accept(Visitor *v) { v->visit(this); };
     };
 
@@ -557,10 +589,10 @@ namespace AST {
     {
         public:
             Return()
-                : KeywordStmt()
+                : KeywordStmt(Kind::Return)
                 {};
 
-            Return(Parser::ReturnStmt *stmt);
+            static bool classof(const Node *node) { return node->kind() == Kind::Return; };
 
             void accept(Visitor *v) { v->visit(this); };
     };
@@ -569,11 +601,19 @@ namespace AST {
     {
         public:
             While()
-                : KeywordStmt()
+                : While(Kind::While)
+                {};
+
+            static bool classof(const Node *node) { return node->kind() >= Kind::While && node->kind() <= Kind::For; };
+
+        protected:
+            While(Kind kind)
+                : KeywordStmt(kind)
                 , stmt(nullptr)
                 {};
 
-            While(Parser::WhileStmt *stmt);
+        public:
+
             void accept(Visitor *v) { v->visit(this); };
             void setScope(SymbolTable::Scope *p);
             
@@ -584,11 +624,12 @@ namespace AST {
     {
         public:
             If()
-                : While()
+                : While(Kind::If)
                 , elseStmt(nullptr)
                 {};
 
-            If(Parser::IfStmt *stmt);
+            static bool classof(const Node *node) { return node->kind() == Kind::If; };
+
             void accept(Visitor *v) { v->visit(this); };
             void setScope(SymbolTable::Scope *p);
 
@@ -599,12 +640,13 @@ namespace AST {
     {
         public:
             For()
-                : While()
+                : While(Kind::For)
                 , startExpr(nullptr)
                 , loopExpr(nullptr)
                 {};
 
-            For(Parser::ForStmt *stmt);
+            static bool classof(const Node *node) { return node->kind() == Kind::For; };
+
             void accept(Visitor *v) { v->visit(this); };
             void setScope(SymbolTable::Scope *p);
             
@@ -617,54 +659,44 @@ namespace AST {
     {
         public:
             Print()
-                :Call()
+                : Call(Kind::Print)
                 {};
-            
-            Print(Parser::PrintStmt *p)
-                : Call(p)
-            {
-                // std::cout << "Print: Generating\n";
-            };
 
+            static bool classof(const Node *node) { return node->kind() == Kind::Print; };
+            
             void accept(Visitor *v) { v->visit(this); };
     };
 
     class ReadInteger: public Call
     {
         public:
-            ReadInteger() : Call(){};
-            ReadInteger(Parser::ReadIntExpr *p) : Call(p) 
-            {
-                // std::cout << "ReadInteger: Generating\n"; 
-            };
+            ReadInteger() : Call(Kind::ReadInteger){};
+            static bool classof(const Node *node) { return node->kind() == Kind::ReadInteger; };
             void accept(Visitor *v) { v->visit(this); };
-            int minCol() { return value.colStart; };
-            int maxCol() { return value.colStart + value.getValue<std::string>().length() + 2; };
+            int minCol() { return value.colStart(); };
+            int maxCol() { return value.colStart() + value.getValue<std::string>().length() + 2; };
     };
 
     class ReadLine: public Call
     {
         public:
-            ReadLine() : Call(){};
-            ReadLine(Parser::ReadLineExpr *p) : Call(p) 
-            {
-                // std::cout << "ReadInteger: Generating\n"; 
-            };
+            ReadLine() : Call(Kind::ReadLine){};
+            static bool classof(const Node *node) { return node->kind() == Kind::ReadLine; };
             void accept(Visitor *v) { v->visit(this); };
-            int minCol() { return value.colStart; };
-            int maxCol() { return value.colStart + value.getValue<std::string>().length() + 2; };
+            int minCol() { return value.colStart(); };
+            int maxCol() { return value.colStart() + value.getValue<std::string>().length() + 2; };
     };
 
     class Program: public Node
     {
         public:
             Program()
-                : Node()
+                : Node(Kind::Program)
                 , vars()
                 , func()
                 {};
 
-            Program(Parser::Program *p);
+            static bool classof(const Node *node) { return node->kind() == Kind::Program; };
 
             void accept(Visitor *v) { v->visit(this); };
             void setScope(SymbolTable::Scope *p);
@@ -2,9 +2,33 @@
 #include "parser/exceptions.hpp"
 
 
+AST::Program* AST::convert(Parser::Program *tree, Common::Arena &arena)
+{
+    ParseTreeConverter converter(arena);
+
+    return static_cast<AST::Program*>(converter.node(tree));
+}
+
+AST::Node* AST::ParseTreeConverter::node(Parser::ParseNode *p)
+{
+    if (p == nullptr)
+        return nullptr;
+
+    pNode = nullptr;
+    p->accept(this);
+
+    Node *converted = pNode;
+    pNode = nullptr;
+
+    if (converted == nullptr)
+        throw Parser::ParseException( p->firstToken() );
+
+    return converted;
+}
+
 void AST::ParseTreeConverter::convert(Parser::Identifier *p)
 {
-    pNode = new AST::Ident(p->ident);
+    pNode = builder.lvalue(p->ident);
 }
 
 void AST::ParseTreeConverter::convert(Parser::DeclarationType *p)
@@ -17,195 +41,164 @@ void AST::ParseTreeConverter::convert(Parser::ReturnType *p)
 
 void AST::ParseTreeConverter::convert(Parser::ReturnStmt *p)
 {
-    pNode = new AST::Return(p);
+    pNode = builder.returnStmt(p->keyword, node(p->expr), p->semiColon);
 }
 
 void AST::ParseTreeConverter::convert(Parser::LValue *p)
 {
-    pNode = new AST::Ident(p->ident->ident);
+    pNode = builder.lvalue(p->ident->ident);
 }
 void AST::ParseTreeConverter::convert(Parser::Constant *p)
 {
-    pNode = new AST::Constant(p->constant);
+    pNode = builder.constant(p->constant);
 }
 
 void AST::ParseTreeConverter::convert(Parser::UnaryExpression *p)
 {
-    switch(p->op.subType)
-    {
-        case Scanner::Token::SubType::UnaryNegative:
-            pNode = new Subtract(p);
-            break;
-        case Scanner::Token::SubType::Not:
-            pNode = new Not(p);
-            break;
-        default:
-            break;
-    }
+    pNode = builder.unary(p->op, node(p->expr));
+}
 
-    if (pNode == nullptr)
-        throw Parser::ParseException( p->firstToken() );
+// the builder picks Print, ReadInteger, ReadLine or Call by identifier
+// the same as the parse tree did
+void AST::ParseTreeConverter::call(Parser::CallExpression *p)
+{
+    TreeBuilder::Call call = builder.call(p->ident->ident, p->lparen);
+
+    for ( auto &actual : p->actuals )
+        builder.addActual(call, node(actual));
 
+    pNode = builder.closeCall(call, p->rparen);
 }
 
 void AST::ParseTreeConverter::convert(Parser::CallExpression *p)
 {
-    pNode = new Call(p);
+    call(p);
 }
 
 void AST::ParseTreeConverter::convert(Parser::ParenExpr *p)
 {
-    p->expr->accept(this);
+    pNode = builder.paren(p->lparen, node(p->expr), p->rparen);
 }
 
 void AST::ParseTreeConverter::convert(Parser::PrintStmt *p)
 {
-    pNode = new Print(p);
+    call(p);
 }
 
 void AST::ParseTreeConverter::convert(Parser::ReadIntExpr *p)
 {
-    pNode = new ReadInteger(p);
+    call(p);
 }
 
 void AST::ParseTreeConverter::convert(Parser::ReadLineExpr *p)
 {
-    pNode = new ReadLine(p);
+    call(p);
 }
 
-void AST::ParseTreeConverter::convert(Parser::RelationalExpression *p)
+// the node made depends on the operator only
+void AST::ParseTreeConverter::binary(Parser::BinaryExpression *p)
 {
-    switch(p->op.subType)
-    {
-        case Scanner::Token::SubType::LessThan:
-            pNode = new LessThan(p);
-            break;
-        case Scanner::Token::SubType::LessEqual:
-            pNode = new LTE(p);
-            break;
-        case Scanner::Token::SubType::GreaterThan:
-            pNode = new GreaterThan(p);
-            break;
-        case Scanner::Token::SubType::GreaterEqual:
-            pNode = new GTE(p);
-            break;
-        default:
-            break;
-    }
+    Node *left = node(p->expr);
+    Node *right = node(p->right);
 
-    if (pNode == nullptr)
-        throw Parser::ParseException( p->firstToken() );
+    pNode = builder.binary(p->op, left, right);
+}
+
+void AST::ParseTreeConverter::convert(Parser::RelationalExpression *p)
+{
+    binary(p);
 }
 
 void AST::ParseTreeConverter::convert(Parser::EqualityExpression *p)
 {
-    switch(p->op.subType)
-    {
-        case Scanner::Token::SubType::Equal :
-            pNode = new Equal(p);
-            break;
-        case Scanner::Token::SubType::NotEqual :
-            pNode = new NotEqual(p);
-            break;
-        default:
-            break;
-    }
-    
-    if (pNode == nullptr)
-        throw Parser::ParseException( p->firstToken() );
+    binary(p);
 }
 
 void AST::ParseTreeConverter::convert(Parser::LogicalExpression *p)
 {
-    switch (p->op.subType)
-    {
-        case Scanner::Token::SubType::And :
-            pNode = new And(p);
-            break;
-        case Scanner::Token::SubType::Or:
-            pNode = new Or(p);
-            break;    
-        default:
-            break;
-    }
-
-    if (pNode == nullptr)
-        throw Parser::ParseException( p->firstToken() );
+    binary(p);
 }
 
 void AST::ParseTreeConverter::convert(Parser::ArithmeticExpression *p)
 {
-    switch(p->op.subType)
-    {
-        case Scanner::Token::SubType::Add:
-            pNode = new Add(p);
-            break;
-        case Scanner::Token::SubType::Subtract:
-            pNode = new Subtract(p);
-            break;
-        case Scanner::Token::SubType::Divide:
-            pNode = new Divide(p);
-            break;
-        case Scanner::Token::SubType::Multiply:
-            pNode = new Multiply(p);
-            break;
-        case Scanner::Token::SubType::Modulus:
-            pNode = new Modulus(p);
-            break;
-        default:
-            std::cout << "Unexpected token: " << p->op.getValue<std::string>() << std::endl;
-    }
-
-    if (pNode == nullptr)
-        throw Parser::ParseException( p->firstToken() );
+    binary(p);
 }
 
 void AST::ParseTreeConverter::convert(Parser::AssignExpression *p)
 {
-    pNode = new Assign(p);
+    binary(p);
 }
 
 void AST::ParseTreeConverter::convert(Parser::BreakStmt *p)
 {
-    pNode = new Break(p);
+    pNode = builder.breakStmt(p->keyword, p->semiColon);
 }
 
 void AST::ParseTreeConverter::convert(Parser::WhileStmt *p)
 {
-    pNode = new While(p);
+    Node *expr = node(p->expr);
+    Node *stmt = node(p->stmt);
+
+    pNode = builder.whileStmt(p->keyword, p->lparen, expr, p->rparen, stmt);
 }
 
 void AST::ParseTreeConverter::convert(Parser::IfStmt *p)
 {
-    pNode = new If(p);
+    Node *expr = node(p->expr);
+    Node *stmt = node(p->stmt);
+    Node *elseStmt = node(p->elseBlock);
+
+    pNode = builder.ifStmt(p->keyword, p->lparen, expr, p->rparen, stmt, p->secondKeyword, elseStmt);
 }
 
 void AST::ParseTreeConverter::convert(Parser::ForStmt *p)
 {
-    pNode = new For(p);
+    Node *startExpr = node(p->startExpr);
+    Node *expr = node(p->expr);
+    Node *loopExpr = node(p->loopExpr);
+    Node *stmt = node(p->stmt);
+
+    pNode = builder.forStmt(p->keyword, p->lparen, startExpr, p->endStart, expr,
+                            p->endExpr, loopExpr, p->rparen, stmt);
 }
 
 void AST::ParseTreeConverter::convert(Parser::StatementBlock *p)
 {
-    pNode = new AST::StatementBlock(p);
-}
+    TreeBuilder::Block block = builder.block(p->lbrace);
 
-void AST::ParseTreeConverter::convert(Parser::FormalVariableDeclaration *p)
-{
-    pNode = new Declaration(p);
-}
+    for (auto &var : p->vars)
+        builder.addVariable(block, var->type->type, var->ident->ident, var->semiColon);
 
-void AST::ParseTreeConverter::convert(Parser::VariableDeclaration *p)
-{
-    pNode = new Declaration(p);
+    for (auto &stmt : p->stmts)
+        builder.addStatement(block, node(stmt));
+
+    pNode = builder.closeBlock(block, p->rbrace);
 }
 
 void AST::ParseTreeConverter::convert(Parser::FunctionDeclaration *p)
 {
-    pNode = new AST::FunctionDeclaration(p);
+    TreeBuilder::Function function = builder.function(p->type->type, p->ident->ident, p->lparen);
+
+    for (auto &formal : p->formals)
+        builder.addFormal(function, formal->type->type, formal->ident->ident, formal->semiColon);
+
+    builder.closeFunction(function, p->rparen, static_cast<StatementBlock*>(node(p->block)));
+    pNode = function;
 }
 
 void AST::ParseTreeConverter::convert(Parser::Program *p)
 {
-    pNode = new AST::Program(p);
-}
\ No newline at end of file
+    TreeBuilder::Program program = builder.program();
+
+    for (auto &decl : p->decls)
+    {
+        auto *var = Common::dyn_cast<Parser::VariableDeclaration>(decl);
+
+        if (var != nullptr)
+            builder.addVariable(program, var->type->type, var->ident->ident, var->semiColon);
+        else
+            builder.addFunction(program, static_cast<FunctionDeclaration*>(node(decl)));
+    }
+
+    pNode = program;
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <visitor/parseVisitor.hpp>
+#include <common/Arena.hpp>
+
 #include "AbstractSyntaxTree.hpp"
+#include "ASTGeneration.hpp"
 
 namespace AST
 {
@@ -9,12 +12,16 @@ namespace AST
 
         class ParseTreeConverter: public Converter {
             public:
-                ParseTreeConverter() 
+                ParseTreeConverter(Common::Arena &arena)
                         : pNode()
+                        , builder(arena)
                 {};
 
                 Node* pNode;
 
+                // converted node of p, nullptr for nullptr
+                Node* node(Parser::ParseNode *p);
+
                 // these are abstract / inherited types 
                 void convert(Parser::ParseNode *p) {};
                 void convert(Parser::BinaryExpression *p) {};
@@ -24,6 +31,10 @@ namespace AST
                 void convert(Parser::KeywordStmt *p) {};
                 void convert(Parser::Declarations *p) {};
 
+                // made by the block, function or program holding them
+                void convert(Parser::VariableDeclaration*) {};
+                void convert(Parser::FormalVariableDeclaration*) {};
+
                 // not sure if I need these
                 void convert(Parser::ReturnType *p);
                 void convert(Parser::DeclarationType *p);
@@ -36,8 +47,6 @@ namespace AST
                 void convert(Parser::LogicalExpression *p);
                 void convert(Parser::RelationalExpression *p);
                 void convert(Parser::EqualityExpression *p);
-                void convert(Parser::VariableDeclaration *p);
-                void convert(Parser::FormalVariableDeclaration *p);
                 void convert(Parser::CallExpression *p);
                 void convert(Parser::PrintStmt  *p);
                 void convert(Parser::ReadIntExpr *p);
@@ -56,7 +65,21 @@ namespace AST
                 void convert(Parser::FunctionDeclaration *p);
 
                 void convert(Parser::Program *p);
+
+            private:
+                TreeBuilder builder;
+
+                void call(Parser::CallExpression *p);
+                void binary(Parser::BinaryExpression *p);
         };
 
+        /**
+         * @brief AST of a parse tree, the same one astGeneration parses to
+         *
+         * @param tree
+         * @param arena the nodes are made in
+         */
+        Program* convert(Parser::Program *tree, Common::Arena &arena);
+
 
 } // namespace AST
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <unordered_map>
+
 #include <AST/AbstractSyntaxTree.hpp>
 #include <code-gen/Entities.hpp>
+#include <common/Arena.hpp>
 
 namespace SymbolTable {
 
@@ -10,9 +13,10 @@ namespace SymbolTable {
         public:
             Exception(char *msg);
             Exception(std::string message, std::string id);
-            Exception(int start, int length, int lineNumber, std::string line, std::string msg);
+            Exception(int start, int length, int lineNumber, std::string_view line, std::string msg);
 
             std::string message;
+            int lineNumber = 0;     // 0 when not tied to a line
 
             const char * what();
     };
@@ -20,8 +24,9 @@ namespace SymbolTable {
     class IdEntry {
 
         public:
-            IdEntry( std::string ident )
-                : ident(ident)
+            IdEntry( Scanner::Token ident )
+                : ident(ident.symbol())
+                , text(ident.value().substr(0, Scanner::Token::identifierMaxLength))
                 , type()
                 , func(false)
                 , block(0)
@@ -30,8 +35,9 @@ namespace SymbolTable {
                 , loaded(false)
                 , paramIndex(-1)
                 {};
-            IdEntry( std::string ident, Scanner::Token::Type type, int block, bool func = false )
-                : ident(ident)
+            IdEntry( Scanner::Token ident, Scanner::Token::Type type, int block, bool func = false )
+                : ident(ident.symbol())
+                , text(ident.value().substr(0, Scanner::Token::identifierMaxLength))
                 , type(type)
                 , func(func)
                 , block(block)
@@ -42,7 +48,8 @@ namespace SymbolTable {
             {
             };
 
-            std::string             ident;
+            Scanner::SymbolId       ident;
+            std::string_view        text;   // the name ident was interned from
             Scanner::Token::Type    type;
             bool                    func;
             CodeGen::Register       *reg;
@@ -61,13 +68,18 @@ namespace SymbolTable {
             */
             int offset;
 
+            // identifier text, only needed for output
+            std::string_view name() const { return text; };
+
     };
 
     class Scope {
 
         public:
-            Scope()
-                : parentScope(nullptr)
+            // entries and child scopes are made in arena
+            Scope(Common::Arena &arena)
+                : arena(arena)
+                , parentScope(nullptr)
                 , table()
                 , funcScope()
                 , numOfParams(0)
@@ -77,6 +89,7 @@ namespace SymbolTable {
             {};
 
 
+            Common::Arena &arena;
             Scope *parentScope;
             int numOfParams;                    // used by functions for type checking
             Scanner::Token::Type returnType;    // used by functions for type check
@@ -87,18 +100,18 @@ namespace SymbolTable {
             int paramOffset;                    // used during code gen
 
 
-            typedef std::map<std::string, IdEntry*>::iterator TableIterator;
-            std::map<std::string, IdEntry*> table;
-            std::map<std::string, Scope*> funcScope;
+            typedef std::unordered_map<Scanner::SymbolId, IdEntry*>::iterator TableIterator;
+            std::unordered_map<Scanner::SymbolId, IdEntry*> table;
+            std::unordered_map<Scanner::SymbolId, Scope*> funcScope;
 
 
-            IdEntry* install(std::string id, Scanner::Token::Type type, int block);
+            IdEntry* install(Scanner::Token id, Scanner::Token::Type type, int block);
             IdEntry* install(AST::Declaration*, int block);
             IdEntry* install(AST::FunctionDeclaration*, int block);
 
-            IdEntry* fakeInstall(std::string id);
+            IdEntry* fakeInstall(Scanner::Token id);
             // IdEntry install(AST::StatementBlock*, int block);
-            IdEntry* idLookup(std::string);
+            IdEntry* idLookup(Scanner::SymbolId id);
 
             Scope * funcLookup(IdEntry *entry);
             Scanner::Token::Type getReturnType();
@@ -36,7 +36,7 @@ void SymbolTable::STVisitor::visit(AST::If *p)
 void SymbolTable::STVisitor::visit(AST::StatementBlock *p)
 {
     Scope *parentScope = currScope;
-    currScope = new Scope();
+    currScope = arena.make<Scope>(arena);
     currScope->parentScope = parentScope;
     p->setScope( currScope );
 
@@ -55,7 +55,7 @@ void SymbolTable::STVisitor::visit(AST::StatementBlock *p)
 void SymbolTable::STVisitor::visit(AST::FunctionDeclaration *p)
 {
     Scope *parentScope = currScope;
-    currScope = new Scope();
+    currScope = arena.make<Scope>(arena);
     currScope->parentScope = parentScope;   // this will be useful for reverse lookups 
     currScope->returnType = p->type;
     p->setScope( currScope );
@@ -72,7 +72,8 @@ void SymbolTable::STVisitor::visit(AST::FunctionDeclaration *p)
 
 
     // Statement block has it's own scope, this allows shadowing of parameters
-    p->stmts->accept(this);
+    if (bodies)
+        p->body()->accept(this);
 
 
     // reset scope
@@ -82,7 +83,7 @@ void SymbolTable::STVisitor::visit(AST::FunctionDeclaration *p)
 
 void SymbolTable::STVisitor::visit(AST::Program *p)
 {
-    currScope = new Scope();
+    currScope = arena.make<Scope>(arena);
     p->setScope( currScope );
 
     // install functions
@@ -93,12 +94,12 @@ void SymbolTable::STVisitor::visit(AST::Program *p)
     for ( auto &node : p->vars )
     {
         // insert into symbol table as global
-        currScope->install(dynamic_cast<AST::Declaration*>(node), 1);
+        currScope->install(Common::cast<AST::Declaration>(node), 1);
     }
 
     for ( auto &node : p->func )
     {
-        SymbolTable::IdEntry *e = currScope->install(dynamic_cast<AST::Declaration*>(node), 1);
+        SymbolTable::IdEntry *e = currScope->install(Common::cast<AST::Declaration>(node), 1);
         e->func = true;
         node->accept(this);
 
@@ -14,17 +14,25 @@ namespace SymbolTable
 {
     class STVisitor: public Visitor {
             public:
-                STVisitor() 
-                        : currScope(nullptr)
+                STVisitor(Common::Arena &arena, bool bodies = true)
+                        : arena(arena)
+                        , currScope(nullptr)
+                        , bodies(bodies)
                 {};
 
+                Common::Arena &arena;
                 Scope* currScope;
 
+                // false to stop at the parameters of each function, leaving
+                // its body unvisited and a lazy one unparsed
+                bool bodies;
+
                 // default acceptor may remove
                 void visit(Acceptor *a) 
                 { 
                         std::cout << "Got acceptor"; 
-                        if (dynamic_cast<AST::FunctionDeclaration *>(a) != nullptr)
+                        // every acceptor is an AST node
+                        if (Common::isa<AST::FunctionDeclaration>(static_cast<AST::Node *>(a)))
                                 std::cout << " w/ function decl";
 
                         std::cout << std::endl;
@@ -20,7 +20,8 @@ SymbolTable::Exception::Exception(std::string message, std::string id)
     message = ss.str();
 }
 
-SymbolTable::Exception::Exception(int start, int length, int lineNumber, std::string line, std::string msg)
+SymbolTable::Exception::Exception(int start, int length, int lineNumber, std::string_view line, std::string msg)
+    : lineNumber(lineNumber)
 {
     std::stringstream ss;
     ss << std::endl
@@ -38,57 +39,57 @@ const char * SymbolTable::Exception::what()
     return message.c_str();
 }
 
-SymbolTable::IdEntry *SymbolTable::Scope::install(std::string id, Scanner::Token::Type type, int block)
+SymbolTable::IdEntry *SymbolTable::Scope::install(Scanner::Token id, Scanner::Token::Type type, int block)
 {
-    auto e = new IdEntry(id, type, block);
+    auto e = arena.make<IdEntry>(id, type, block);
 
-    TableIterator it ( table.find(id) );
+    TableIterator it ( table.find(id.symbol()) );
 
     // Handle name collisions within a single scope
     if (it != table.end())
-        throw Exception("Cannot redeclare variable in same scope", id);
+        throw Exception("Cannot redeclare variable in same scope", std::string(e->name()));
         // throw std::runtime_error("Cannot redeclare variable in same scope");
 
-    table.insert( {id, e} );
+    table.insert( {id.symbol(), e} );
     return e;
 }
 
 SymbolTable::IdEntry *SymbolTable::Scope::install(AST::Declaration* id, int block)
 {
-    auto e = new IdEntry(id->ident.getValue<std::string>() , id->type, block);
-    TableIterator it ( table.find(id->ident.getValue<std::string>()) );
+    auto e = arena.make<IdEntry>(id->ident, id->type, block);
+    TableIterator it ( table.find(id->ident.symbol()) );
 
     // Handle name collisions within a single scope
     if (it != table.end())
-        throw Exception(id->ident.colStart, id->ident.value.length(), id->ident.lineNumber, id->ident.lineInfo, "Cannot redeclare variable in same scope");
+        throw Exception(id->ident.colStart(), id->ident.value().length(), id->ident.lineNumber(), id->ident.lineInfo(), "Cannot redeclare variable in same scope");
         // throw std::runtime_error("Cannot redeclare variable in same scope");
-    table.insert( {id->ident.value, e} );
+    table.insert( {id->ident.symbol(), e} );
     return e;
 }
 
 SymbolTable::IdEntry *SymbolTable::Scope::install(AST::FunctionDeclaration* id, int block)
 {
-    auto e = new IdEntry(id->ident.getValue<std::string>() , id->type, block, true);
-    TableIterator it ( table.find(id->ident.getValue<std::string>()) );
+    auto e = arena.make<IdEntry>(id->ident, id->type, block, true);
+    TableIterator it ( table.find(id->ident.symbol()) );
 
     // Handle name collisions within a single scope
     if (it != table.end())
-        throw Exception(id->ident.colStart, id->ident.value.length(), id->ident.lineNumber, id->ident.lineInfo, "Cannot redeclare variable in same scope");
+        throw Exception(id->ident.colStart(), id->ident.value().length(), id->ident.lineNumber(), id->ident.lineInfo(), "Cannot redeclare variable in same scope");
         // throw std::runtime_error("Cannot redeclare variable in same scope");
-    table.insert( {id->ident.value, e} );
+    table.insert( {id->ident.symbol(), e} );
     return e;
 }
 
-SymbolTable::IdEntry *SymbolTable::Scope::fakeInstall(std::string str)
+SymbolTable::IdEntry *SymbolTable::Scope::fakeInstall(Scanner::Token id)
 {
-    auto e = new IdEntry(str);
-    table.insert( {str, e});
+    auto e = arena.make<IdEntry>(id);
+    table.insert( {id.symbol(), e});
 
     return e;
 }
 
 
-SymbolTable::IdEntry* SymbolTable::Scope::idLookup(std::string id)
+SymbolTable::IdEntry* SymbolTable::Scope::idLookup(Scanner::SymbolId id)
 {
     TableIterator it ( table.find(id) );
 
@@ -99,7 +100,7 @@ SymbolTable::IdEntry* SymbolTable::Scope::idLookup(std::string id)
             return parentScope->idLookup(id);
         }
         else {
-            // throw std::runtime_error("No symbol with id: " + id);
+            // throw std::runtime_error("No symbol with id: " + std::string(Scanner::Symbols::name(id)));
             return nullptr;
         }
     }
@@ -154,7 +155,7 @@ std::string SymbolTable::Scope::toString(int &space)
 
     ss << std::setw(space) << " " << "Scope:\n";
     for ( const auto &pair : table ) {
-        ss << std::setw(space+3) << " " << pair.first << "\n";
+        ss << std::setw(space+3) << " " << pair.second->name() << "\n";
     }
 
     space += 3;
@@ -181,10 +182,10 @@ SymbolTable::Scope * SymbolTable::Scope::funcLookup(SymbolTable::IdEntry* entry)
     if (parentScope != nullptr)
         return parentScope->funcLookup(entry);
 
-    std::map<std::string, SymbolTable::Scope*>::iterator it ( funcScope.find(entry->ident) );
+    auto it ( funcScope.find(entry->ident) );
 
     if ( it == funcScope.end() )
-        throw std::runtime_error( "No Scope for function " + entry->ident );
+        throw std::runtime_error( "No Scope for function " + std::string(entry->name()) );
 
     return it->second;
 
@@ -192,10 +193,17 @@ SymbolTable::Scope * SymbolTable::Scope::funcLookup(SymbolTable::IdEntry* entry)
 
 
 
-void SymbolTable::generate(AST::Program *p)
+void SymbolTable::generate(AST::Program *p, Common::Arena &arena)
 {
-    SymbolTable::STVisitor visitor = SymbolTable::STVisitor();
+    SymbolTable::STVisitor visitor(arena);
 
     p->accept(&visitor);
 
+}
+
+void SymbolTable::generateGlobals(AST::Program *p, Common::Arena &arena)
+{
+    SymbolTable::STVisitor visitor(arena, false);
+
+    p->accept(&visitor);
 }
\ No newline at end of file
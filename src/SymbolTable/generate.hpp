@@ -2,11 +2,17 @@
 
 
 #include <AST/AbstractSyntaxTree.hpp>
+#include <common/Arena.hpp>
 
 
 
 namespace SymbolTable {
 
 
-    void generate(AST::Program *prog);
+    // scopes and entries are made in arena, they live as long as it does
+    void generate(AST::Program *prog, Common::Arena &arena);
+
+    // the global scope and the parameter scope of each function, bodies are
+    // not visited
+    void generateGlobals(AST::Program *prog, Common::Arena &arena);
 }
\ No newline at end of file
@@ -3,19 +3,29 @@
 #include "Entities.hpp"
 
 #include <iomanip>
+#include <fstream>
 
 namespace CodeGen {
 
-    void generate(AST::Program *p, std::string file_name)
+    bool generate(AST::Program *p, std::ostream &assembly, Common::Diagnostics &diagnostics, Common::Arena &arena)
     {
-        CodeGenVisitor v;
+        // labels and registers are numbered from the start for every program
+        Label::counter = 0;
+        Register::registerIndex = 0;
+        FloatingRegister::registerIndex = 0;
+
+        CodeGenVisitor v(diagnostics, arena);
         p->accept(&v);
 
         // possible optimization step
 
-        v.write(file_name);
+        // If encountered error skip writing
+        if (v.error)
+            return false;
+
+        v.write(assembly);
 
-        return;
+        return true;
     }
 
     Immediate::Immediate()
@@ -52,34 +62,36 @@ namespace CodeGen {
     }
 
     Label::Label()
+        : InstructionStreamItems(Kind::Label)
     {
 
     }
 
     Label::Label(std::string value)
-        : label(value)
+        : InstructionStreamItems(Kind::Label)
+        , label(value)
     {
 
     }
 
     int Label::counter = 0;
 
-    Label * Label::Next()
+    Label * Label::Next(Common::Arena &arena)
     {
         std::stringstream ss;
 
         ss << "_L" << counter ++;
 
-        return new Label(ss.str());
+        return arena.make<Label>(ss.str());
     }
 
-    Label * Label::Next(std::string info)
+    Label * Label::Next(Common::Arena &arena, std::string info)
     {
         std::stringstream ss;
 
         ss << "_L" << info << counter ++;
 
-        return new Label(ss.str());
+        return arena.make<Label>(ss.str());
 
     }
 
@@ -124,12 +136,12 @@ namespace CodeGen {
         return ss.str();
     }
 
-    Register * Register::Next()
+    Register * Register::Next(Common::Arena &arena)
     {
         registerIndex = (registerIndex + 1)%registerCount;
         std::stringstream ss;
         ss << "t" << registerIndex;
-        return new Register(ss.str());
+        return arena.make<Register>(ss.str());
     }
 
     void Register::Free()
@@ -159,7 +171,7 @@ namespace CodeGen {
         return ss.str();
     }
 
-    FloatingRegister* FloatingRegister::Next()
+    FloatingRegister* FloatingRegister::Next(Common::Arena &arena)
     {
         registerIndex = (registerIndex + 1)%registerCount;
         std::stringstream ss;
@@ -168,7 +180,7 @@ namespace CodeGen {
         // 1 * 2 = 2,3  second
         // 2 * 2 = 4,5  third
         ss << "f" << registerIndex*2;  
-        return new FloatingRegister(ss.str());
+        return arena.make<FloatingRegister>(ss.str());
     }
 
     void FloatingRegister::Free()
@@ -198,20 +210,23 @@ namespace CodeGen {
     }
 
     Comment::Comment()
-        : comment()
+        : InstructionStreamItems(Kind::Comment)
+        , comment()
         , dataSize(nullptr)
     {
     }
 
     Comment::Comment(std::string comment)
-        : comment(comment)
+        : InstructionStreamItems(Kind::Comment)
+        , comment(comment)
         , dataSize(nullptr)
     {
 
     }
 
     Comment::Comment(std::string comment, int *dataSize)
-        :comment(comment)
+        : InstructionStreamItems(Kind::Comment)
+        , comment(comment)
         , dataSize(dataSize)
     {
 
@@ -230,12 +245,14 @@ namespace CodeGen {
     }
 
     Command::Command()
+        : InstructionStreamItems(Kind::Command)
     {
 
     }
 
     Command::Command(std::string command)
-        : command(command)
+        : InstructionStreamItems(Kind::Command)
+        , command(command)
     {
 
     }
@@ -253,7 +270,8 @@ namespace CodeGen {
     }
 
     Instruction::Instruction() 
-        : op()
+        : InstructionStreamItems(Kind::Instruction)
+        , op()
         , operand1(nullptr)
         , operand2(nullptr)
         , operand3(nullptr)
@@ -262,7 +280,8 @@ namespace CodeGen {
     }
 
     Instruction::Instruction(std::string op, Location* op1)
-        : op(op)
+        : InstructionStreamItems(Kind::Instruction)
+        , op(op)
         , operand1(op1)
         , operand2(nullptr)
         , operand3(nullptr)
@@ -272,7 +291,8 @@ namespace CodeGen {
 
     Instruction::Instruction(std::string op, Location* op1, 
         Location* op2)
-        : op(op)
+        : InstructionStreamItems(Kind::Instruction)
+        , op(op)
         , operand1(op1)
         , operand2(op2)
         , operand3(nullptr)
@@ -282,7 +302,8 @@ namespace CodeGen {
     
     Instruction::Instruction(std::string op, Location* op1, 
         Location* op2, Location* op3)
-        : op(op)
+        : InstructionStreamItems(Kind::Instruction)
+        , op(op)
         , operand1(op1)
         , operand2(op2)
         , operand3(op3)
@@ -309,8 +330,10 @@ namespace CodeGen {
         return ss.str();
     }
 
-    CodeGenVisitor::CodeGenVisitor()
-        : instructions()
+    CodeGenVisitor::CodeGenVisitor(Common::Diagnostics &diagnostics, Common::Arena &arena)
+        : diagnostics(diagnostics)
+        , arena(arena)
+        , instructions()
         , tmpCounter(0)
         , labelCounter(1)
         , error(false)
@@ -327,9 +350,9 @@ namespace CodeGen {
     void CodeGenVisitor::emit(std::string output)
     {
         if (output.at(0) == '.' || output.at(0) == '_')
-            instructions.push_back(new Command(output));
+            instructions.push_back(arena.make<Command>(output));
         else
-            instructions.push_back(new Comment(output));
+            instructions.push_back(arena.make<Comment>(output));
     }
     
     void CodeGenVisitor::emit(Comment *c)
@@ -339,7 +362,7 @@ namespace CodeGen {
 
     void CodeGenVisitor::emit(std::string output, int *dataSize)
     {
-        instructions.push_back(new Comment(output, dataSize));
+        instructions.push_back(arena.make<Comment>(output, dataSize));
     }
 
     void CodeGenVisitor::emit(Label *label)
@@ -349,21 +372,21 @@ namespace CodeGen {
 
     void CodeGenVisitor::emit(std::string op, Location* operand1)
     {
-        instructions.push_back(new Instruction(op, operand1));
+        instructions.push_back(arena.make<Instruction>(op, operand1));
     }
 
     void CodeGenVisitor::emit(std::string op, Location* operand1, 
         Location* operand2)
     {
         instructions.push_back(
-                new Instruction(op, operand1, operand2) );
+                arena.make<Instruction>(op, operand1, operand2) );
     }
 
     void CodeGenVisitor::emit(std::string op, Location* operand1, 
         Location* operand2, Location* operand3)
     {
         instructions.push_back(
-            new Instruction(op, operand1, operand2, operand3));
+            arena.make<Instruction>(op, operand1, operand2, operand3));
     }
 
     void CodeGenVisitor::addComment(Comment* comment)
@@ -371,28 +394,14 @@ namespace CodeGen {
         instructions.back()->comment = comment;
     }
 
-    void CodeGenVisitor::write(std::string file_name)
+    void CodeGenVisitor::write(std::ostream &file)
     {
-
-        // If encountered error skip file writing
-        if (error)
-            return;
-
-        std::stringstream ss;
-        ss << file_name << ".s";
-
-
-        std::string actual_file_name( ss.str() );
-
-        // std::cout << "Opening file with name: " << actual_file_name << std::endl;
-        std::ofstream file;
-        file.open( actual_file_name );
-
         for( auto instrs : instructions )
         {
             
             std::string spacing("\t");
-            if (dynamic_cast<Label*>(instrs) != nullptr )
+            bool label = Common::isa<Label>(instrs);
+            if (label)
             {
                 spacing = "  ";
             }
@@ -401,7 +410,7 @@ namespace CodeGen {
             file    << spacing
                     << instr;
 
-            if (dynamic_cast<Label*>(instrs) != nullptr )
+            if (label)
             {
                 spacing = "  ";
                 file << ": ";
@@ -412,8 +421,6 @@ namespace CodeGen {
             file << std::endl;
 
         }
-
-        file.close();
     }
 
     void CodeGenVisitor::loadSubExpr(AST::Node *p, Register *reg)
@@ -426,7 +433,7 @@ namespace CodeGen {
             default:
                 emit("lw", reg, p->mem);
         }
-        addComment(new Comment("fill " + p->memName + " to " + reg->emit() + " from " + p->mem->emit()));
+        addComment(arena.make<Comment>("fill " + p->memName + " to " + reg->emit() + " from " + p->mem->emit()));
     }
 
     void CodeGenVisitor::loadSubExprs(AST::Node *left, 
@@ -447,7 +454,7 @@ namespace CodeGen {
             default:
                 emit("sw", reg, mem);
         }
-        addComment(new Comment("spill " + tmpName + " from " + reg->emit() + " to " + mem->emit()));
+        addComment(arena.make<Comment>("spill " + tmpName + " from " + reg->emit() + " to " + mem->emit()));
     }
 
     Memory * CodeGenVisitor::setupSubExpr(AST::Node *left, 
@@ -465,29 +472,29 @@ namespace CodeGen {
         ss << "_tmp" << tmpCounter++;
         tmpName = ss.str();
         
-        return new Memory("fp", -offset);
+        return arena.make<Memory>("fp", -offset);
     }
 
     void CodeGenVisitor::identCheck(AST::Node *p, 
         SymbolTable::Scope *pScope)
     {
-        if (dynamic_cast<AST::Ident*>(p) != nullptr)
+        if (AST::Ident* ident = Common::dyn_cast<AST::Ident>(p))
         {
-            AST::Ident* ident = dynamic_cast<AST::Ident*>(p);
-            SymbolTable::IdEntry *e = pScope->idLookup(ident->value.getValue<std::string>());
+            SymbolTable::IdEntry *e = pScope->idLookup(ident->value.symbol());
 
             // If var is not loaded and not a parameter then we throw error
             //  params will always be loaded
             if (e != nullptr && ! e->loaded && e->block != 2)
             {
-                std::cout   << std::endl
-                            << "*** Error line " << ident->value.lineNumber << ".\n"
-                            << ident->value.lineInfo << std::endl
+                std::stringstream ss;
+                ss          << std::endl
+                            << "*** Error line " << ident->value.lineNumber() << ".\n"
+                            << ident->value.lineInfo() << std::endl
                             << std::setw(ident->minCol() -1 ) << " "
                             << std::setfill('^') << std::setw(ident->maxCol() - ident->minCol()) << "" << std::endl
                             << "*** Invalid expression: use before load on var: " << ident->value.getValue<std::string>()
                             << std::endl;
-                std::cout << std::setfill(' ');
+                diagnostics.report(Common::Diagnostics::Stage::CodeGen, ident->value.lineNumber(), ss.str());
 
                 // set loaded to true and continue, will not write out assembly code
                 // though
@@ -501,10 +508,9 @@ namespace CodeGen {
     void CodeGenVisitor::identLoaded(AST::Node *p,
         SymbolTable::Scope *pScope)
     {
-        if (dynamic_cast<AST::Ident*>(p) != nullptr)
+        if (AST::Ident* ident = Common::dyn_cast<AST::Ident>(p))
         {
-            AST::Ident* ident = dynamic_cast<AST::Ident*>(p);
-            SymbolTable::IdEntry *e = pScope->idLookup(ident->value.getValue<std::string>());
+            SymbolTable::IdEntry *e = pScope->idLookup(ident->value.symbol());
 
             if (e != nullptr)
                 e->loaded = true;
@@ -522,19 +528,19 @@ namespace CodeGen {
 
         if (p->left->mem != nullptr)
         {
-            Register *lreg = Register::Next();
-            Register *oreg = Register::Next();
+            Register *lreg = Register::Next(arena);
+            Register *oreg = Register::Next(arena);
 
             if (p->left->outType == Scanner::Token::Type::Double)
             {
-                lreg = FloatingRegister::Next();
-                oreg = FloatingRegister::Next();
+                lreg = FloatingRegister::Next(arena);
+                oreg = FloatingRegister::Next(arena);
 
                 int offset = p->pScope->getNextOffset(); // get next offset to save double
                 // mem = new Memory("fp", -offset);
             }
 
-            emit(new Comment( tmp + " = " + p->op.lineInfo.substr(start-2, end-start+2)) ); // expression start
+            emit(arena.make<Comment>( tmp + " = " + std::string(p->op.lineInfo().substr(start-2, end-start+2))) ); // expression start
             loadSubExpr(p->left, lreg);
 
             emit(op, oreg, lreg);
@@ -545,8 +551,8 @@ namespace CodeGen {
 
             if (p->left->outType == Scanner::Token::Type::Double)
             {
-                FloatingRegister::Next();
-                FloatingRegister::Next();
+                FloatingRegister::Next(arena);
+                FloatingRegister::Next(arena);
             }
             Register::Free();
             Register::Free();
@@ -554,7 +560,7 @@ namespace CodeGen {
         }
         else
         {
-            std::cout << "Could not assign due to invalid memory location\n";
+            diagnostics.report(Common::Diagnostics::Stage::CodeGen, 0, "Could not assign due to invalid memory location\n");
         }
 
         p->mem = mem;
@@ -573,21 +579,21 @@ namespace CodeGen {
         if (p->left->mem != nullptr && p->right->mem != nullptr)
         {
             // load right location
-            Register *rreg = Register::Next();
-            Register *lreg = Register::Next();
-            Register *oreg = Register::Next();
+            Register *rreg = Register::Next(arena);
+            Register *lreg = Register::Next(arena);
+            Register *oreg = Register::Next(arena);
 
             if (p->left->outType == Scanner::Token::Type::Double)
             {
-                rreg = FloatingRegister::Next();
-                lreg = FloatingRegister::Next();
-                oreg = FloatingRegister::Next();
+                rreg = FloatingRegister::Next(arena);
+                lreg = FloatingRegister::Next(arena);
+                oreg = FloatingRegister::Next(arena);
 
                 int offset = p->pScope->getNextOffset(); // get next offset to save double
                 // mem = new Memory("fp", -offset);
             }
 
-            emit(new Comment( tmp + " = " + p->op.lineInfo.substr(start-2, end-start+2)) ); // expression start
+            emit(arena.make<Comment>( tmp + " = " + std::string(p->op.lineInfo().substr(start-2, end-start+2))) ); // expression start
             loadSubExprs(p->left, lreg, p->right, rreg);
             // add instr
             emit(op, oreg, lreg, rreg);
@@ -602,9 +608,9 @@ namespace CodeGen {
             /** Free all registers used for expression */
             if (p->left->outType == Scanner::Token::Type::Double)
             {
-                FloatingRegister::Next();
-                FloatingRegister::Next();
-                FloatingRegister::Next();
+                FloatingRegister::Next(arena);
+                FloatingRegister::Next(arena);
+                FloatingRegister::Next(arena);
             }
             Register::Free();
             Register::Free();
@@ -612,7 +618,7 @@ namespace CodeGen {
         }
         else
         {
-            std::cout << "Could not assign due to invalid memory location\n";
+            diagnostics.report(Common::Diagnostics::Stage::CodeGen, 0, "Could not assign due to invalid memory location\n");
         }
 
         p->mem = mem;
@@ -631,31 +637,31 @@ namespace CodeGen {
         // mem = new Memory("fp", -offset);
 
         // Load FP regs
-        FloatingRegister *lreg = FloatingRegister::Next();
-        FloatingRegister *rreg = FloatingRegister::Next();
+        FloatingRegister *lreg = FloatingRegister::Next(arena);
+        FloatingRegister *rreg = FloatingRegister::Next(arena);
 
         loadSubExpr(p->left, lreg);
         loadSubExpr(p->right, rreg);
         
         // FP compare a < b
-        addComment(new Comment("Start of FP comparison"));
+        addComment(arena.make<Comment>("Start of FP comparison"));
         emit(op, lreg, rreg);
         
 
-        Label *fbranch = Label::Next();
-        Label *ebranch = Label::Next();
+        Label *fbranch = Label::Next(arena);
+        Label *ebranch = Label::Next(arena);
 
         // Branch on FP compare if false
         emit("bc1f", fbranch);
-        addComment(new Comment("Jump to false branch"));
+        addComment(arena.make<Comment>("Jump to false branch"));
         
         // get normal register
-        Register *oreg = Register::Next();
-        Immediate *immFbranch = new Immediate("0");
-        Immediate *immTbranch = new Immediate("1");
+        Register *oreg = Register::Next(arena);
+        Immediate *immFbranch = arena.make<Immediate>("0");
+        Immediate *immTbranch = arena.make<Immediate>("1");
         if (invert)
         {
-            emit(new Comment("Inverting branch results"));
+            emit(arena.make<Comment>("Inverting branch results"));
             // swap values
             immFbranch->immediate = "1";
             immTbranch->immediate = "0";
@@ -664,30 +670,30 @@ namespace CodeGen {
         
         // Branch True
         // li $t*, 1    // return 1
-        emit(new Comment("True branch"));
+        emit(arena.make<Comment>("True branch"));
         emit("li", oreg, immTbranch);
-        addComment(new Comment("fill " + tmp + " to " + oreg->emit() + " from value " + immTbranch->emit()));
+        addComment(arena.make<Comment>("fill " + tmp + " to " + oreg->emit() + " from value " + immTbranch->emit()));
         // sw $t*, out memory
         emit("sw", oreg, mem);
-        addComment(new Comment("spill " + tmp + " from " + oreg->emit() + " to " + mem->emit()));
+        addComment(arena.make<Comment>("spill " + tmp + " from " + oreg->emit() + " to " + mem->emit()));
         // branch end
         emit("b", ebranch);
-        addComment(new Comment("Unconditional branch to end"));
+        addComment(arena.make<Comment>("Unconditional branch to end"));
 
         // Branch False
         emit(fbranch);
-        addComment(new Comment("False branch"));
+        addComment(arena.make<Comment>("False branch"));
         // li $t*, 0    // return 0
         emit("li", oreg, immFbranch);
-        addComment(new Comment("fill " + tmp + " to " + oreg->emit() + " from value " + immFbranch->emit()));
+        addComment(arena.make<Comment>("fill " + tmp + " to " + oreg->emit() + " from value " + immFbranch->emit()));
         // sw $t*, out memory
         emit("sw", oreg, mem);
-        addComment(new Comment("spill " + tmp + " from " + oreg->emit() + " to " + mem->emit()));
+        addComment(arena.make<Comment>("spill " + tmp + " from " + oreg->emit() + " to " + mem->emit()));
         // branch end
 
         // Branch end
         emit(ebranch);
-        addComment(new Comment("End of FP comparison"));
+        addComment(arena.make<Comment>("End of FP comparison"));
 
         identCheck(p->left, p->pScope);
         identCheck(p->right, p->pScope);
@@ -700,20 +706,20 @@ namespace CodeGen {
 
     void CodeGenVisitor::pushParam(AST::Node *p)
     {
-        Register *reg = Register::Next();
+        Register *reg = Register::Next(arena);
 
         if (p->outType == Scanner::Token::Type::Double)
-            reg = FloatingRegister::Next();
+            reg = FloatingRegister::Next(arena);
 
-        emit(new Comment("PushParam " + p->memName));
+        emit(arena.make<Comment>("PushParam " + p->memName));
 
         // allocate space on stack for param
-        Immediate *imm = new Immediate("4");
+        Immediate *imm = arena.make<Immediate>("4");
         if (p->outType == Scanner::Token::Type::Double )
             imm->immediate = "8";
 
-        emit("subu", new Register("sp"), new Register("sp"), imm);
-        addComment(new Comment("decrement sp to make space for param"));
+        emit("subu", arena.make<Register>("sp"), arena.make<Register>("sp"), imm);
+        addComment(arena.make<Comment>("decrement sp to make space for param"));
 
         // load parameter into reg
         loadSubExpr(p, reg);
@@ -721,7 +727,7 @@ namespace CodeGen {
         // addComment(new Comment("fill " + p->memName + " to " + reg->emit() + " from " + p->mem->emit()));
 
         // push parameter onto stack for call 
-        Memory *mem = new Memory("sp", 4);
+        Memory *mem = arena.make<Memory>("sp", 4);
         if (p->outType == Scanner::Token::Type::Double )
             mem->offset += 4;
 
@@ -743,9 +749,9 @@ namespace CodeGen {
         std::stringstream ss2;
         ss2 << num*4;
 
-        emit(new Comment(ss.str()));
-        emit("add", new Register("sp"), new Register("sp"), new Immediate(ss2.str()));
-        addComment(new Comment("pop params off stack"));
+        emit(arena.make<Comment>(ss.str()));
+        emit("add", arena.make<Register>("sp"), arena.make<Register>("sp"), arena.make<Immediate>(ss2.str()));
+        addComment(arena.make<Comment>("pop params off stack"));
     }
 
     void CodeGenVisitor::CallFormalVisit(AST::Call *p)
@@ -772,8 +778,8 @@ namespace CodeGen {
     {
         // get new temporary offset
         int offset = p->pScope->getNextOffset();
-        Memory *mem = new Memory("fp", -offset);
-        Register *reg = Register::Next();
+        Memory *mem = arena.make<Memory>("fp", -offset);
+        Register *reg = Register::Next(arena);
 
         if (p->outType == Scanner::Token::Type::Double)
         {
@@ -781,14 +787,14 @@ namespace CodeGen {
             // mem = new Memory("fp", -offset);
 
             // Return Value in $f6
-            reg = new FloatingRegister("f6");
+            reg = arena.make<FloatingRegister>("f6");
 
             saveSubExpr(p, reg, mem, tmpName);
         }
         else
         {
-            emit("move", reg, new Register("v0"));
-            addComment(new Comment("copy function return value from $v0"));
+            emit("move", reg, arena.make<Register>("v0"));
+            addComment(arena.make<Comment>("copy function return value from $v0"));
 
             saveSubExpr(p, reg, mem, tmpName);
             // emit("sw", reg, mem);
@@ -805,17 +811,17 @@ namespace CodeGen {
 
     void CodeGenVisitor::functionReturn()
     {
-        emit("move", new Register("sp"), new Register("fp"));
-        addComment(new Comment("pop callee frame off stack"));
+        emit("move", arena.make<Register>("sp"), arena.make<Register>("fp"));
+        addComment(arena.make<Comment>("pop callee frame off stack"));
 
-        emit("lw", new Register("ra"), new Memory("fp", -4));
-        addComment(new Comment("restore saved ra"));
+        emit("lw", arena.make<Register>("ra"), arena.make<Memory>("fp", -4));
+        addComment(arena.make<Comment>("restore saved ra"));
 
-        emit("lw", new Register("fp"), new Memory("fp", 0));
-        addComment(new Comment("restore saved fp"));
+        emit("lw", arena.make<Register>("fp"), arena.make<Memory>("fp", 0));
+        addComment(arena.make<Comment>("restore saved fp"));
 
-        emit("jr", new Register("ra"));
-        addComment(new Comment("return from function"));
+        emit("jr", arena.make<Register>("ra"));
+        addComment(arena.make<Comment>("return from function"));
     }
 
 
@@ -830,7 +836,7 @@ namespace CodeGen {
     void CodeGenVisitor::visit(AST::Ident *p)
     {
         // lookup in symbol table to retrieve register
-        SymbolTable::IdEntry *e = p->pScope->idLookup(p->value.getValue<std::string>());
+        SymbolTable::IdEntry *e = p->pScope->idLookup(p->value.symbol());
 
         p->reg = e->reg;
 
@@ -839,7 +845,7 @@ namespace CodeGen {
         if (e->block == 1)
             reg = "gp";
 
-        p->mem = new Memory(reg, e->offset);
+        p->mem = arena.make<Memory>(reg, e->offset);
         p->memName = p->value.getValue<std::string>();
     }
 
@@ -849,26 +855,26 @@ namespace CodeGen {
         // get next offset for temporary
 
         int offset = p->pScope->getNextOffset();
-        Memory *mem = new Memory("fp", -offset);
+        Memory *mem = arena.make<Memory>("fp", -offset);
 
         std::stringstream ss;
         ss << "_tmp" << tmpCounter++;
         std::string tmp(ss.str());
         std::string constant(p->value.getValue<std::string>());
 
-        emit(new Comment(tmp + " = " + constant));
+        emit(arena.make<Comment>(tmp + " = " + constant));
 
-        Register *reg = Register::Next(); //get next register
+        Register *reg = Register::Next(arena); //get next register
 
-        switch (p->value.type)
+        switch (p->value.type())
         {
             case Scanner::Token::Type::StringConstant:
                 {
                     emit(".data");
-                    addComment(new Comment("create string constant marked with label"));
+                    addComment(arena.make<Comment>("create string constant marked with label"));
                     std::stringstream ss;
                     ss << "_string" << labelCounter++;
-                    Label *l = new Label(ss.str());
+                    Label *l = arena.make<Label>(ss.str());
                     
                     ss.str("");
                     ss << l->emit() << ": .asciiz " << constant ;
@@ -876,16 +882,16 @@ namespace CodeGen {
                     emit(ss.str());
                     emit(".text");
                     emit("la", reg, l);
-                    addComment(new Comment("load label"));
+                    addComment(arena.make<Comment>("load label"));
                 }
                 break;
             case Scanner::Token::Type::DoubleConstant:
                 // must get new offset for floating point value
-                reg = FloatingRegister::Next();
+                reg = FloatingRegister::Next(arena);
                 offset = p->pScope->getNextOffset();
                 // mem = new Memory("fp", -offset);
-                emit("li.d", reg, new Immediate(constant));
-                addComment(new Comment("load constant value " + constant + " into " + reg->emit() ));
+                emit("li.d", reg, arena.make<Immediate>(constant));
+                addComment(arena.make<Comment>("load constant value " + constant + " into " + reg->emit() ));
                 break;
             case Scanner::Token::Type::BoolConstant :
                 if (constant.compare("true") == 0)
@@ -898,14 +904,14 @@ namespace CodeGen {
                 }
                 // set constant "true" or "false" to int value so fallback to default emit
             default :
-                emit("li", reg, new Immediate(constant));
-                addComment(new Comment("load constant value " + constant + " into " + reg->emit() ));
+                emit("li", reg, arena.make<Immediate>(constant));
+                addComment(arena.make<Comment>("load constant value " + constant + " into " + reg->emit() ));
                 break;
 
         }
 
         // Each constant will be saved to memory locaiton
-        if (p->value.type == Scanner::Token::Type::DoubleConstant)
+        if (p->value.type() == Scanner::Token::Type::DoubleConstant)
         {
             emit("s.d", reg, mem);
             FloatingRegister::Free();
@@ -915,7 +921,7 @@ namespace CodeGen {
             emit("sw", reg, mem);
         }
         Register::Free();
-        addComment(new Comment("spill " + tmp + " from " + reg->emit() + " to " + mem->emit()));
+        addComment(arena.make<Comment>("spill " + tmp + " from " + reg->emit() + " to " + mem->emit()));
 
         p->mem = mem;
         p->memName = tmp;
@@ -1078,18 +1084,18 @@ namespace CodeGen {
         //  0 == 0  = 1
         p->left->accept( this );
 
-        Register *reg = Register::Next();
-        Register *lvalue = Register::Next();
-        Register *outValue = Register::Next();
+        Register *reg = Register::Next(arena);
+        Register *lvalue = Register::Next(arena);
+        Register *outValue = Register::Next(arena);
         int offset = p->pScope->getNextOffset();
-        Memory *mem = new Memory("fp", -offset);
+        Memory *mem = arena.make<Memory>("fp", -offset);
 
         std::stringstream ss;
         ss << "_tmp" << tmpCounter++;
         std::string tmp(ss.str());
 
-        emit("li", reg, new Immediate("0"));
-        addComment(new Comment("load constant value '0' into " + reg->emit() ));
+        emit("li", reg, arena.make<Immediate>("0"));
+        addComment(arena.make<Comment>("load constant value '0' into " + reg->emit() ));
 
         emit("lw", lvalue, p->left->mem);
         emit("seq", outValue, lvalue, reg);
@@ -1129,12 +1135,12 @@ namespace CodeGen {
         if (p->left->mem != nullptr && p->right->mem != nullptr)
         {
             // load right location
-            emit(new Comment(p->left->memName + " = " + p->right->memName));
+            emit(arena.make<Comment>(p->left->memName + " = " + p->right->memName));
             
-            Register *reg = Register::Next();
+            Register *reg = Register::Next(arena);
 
             if (p->left->outType == Scanner::Token::Type::Double)
-                reg = FloatingRegister::Next();
+                reg = FloatingRegister::Next(arena);
             
             loadSubExpr(p->right, reg);
             // emit("lw", reg, p->right->mem);
@@ -1153,7 +1159,7 @@ namespace CodeGen {
         }
         else
         {
-            std::cout << "Could not assign due to invalid memory location\n";
+            diagnostics.report(Common::Diagnostics::Stage::CodeGen, 0, "Could not assign due to invalid memory location\n");
         }
     }
 
@@ -1164,17 +1170,17 @@ namespace CodeGen {
         if (p->expr != nullptr)
         {
             p->expr->accept(this);
-            emit(new Comment("Return " + p->expr->memName));
+            emit(arena.make<Comment>("Return " + p->expr->memName));
 
             Register *reg;
 
             if ( p->outType == Scanner::Token::Type::Double )
             {
-                reg = FloatingRegister::Next();
+                reg = FloatingRegister::Next(arena);
                 emit("l.d", reg, p->expr->mem);
-                addComment(new Comment("fill " + p->expr->memName + " to " + reg->emit() + " from " + p->expr->mem->emit()));
+                addComment(arena.make<Comment>("fill " + p->expr->memName + " to " + reg->emit() + " from " + p->expr->mem->emit()));
                 
-                FloatingRegister * outreg = new FloatingRegister("f6");
+                FloatingRegister * outreg = arena.make<FloatingRegister>("f6");
                 // TODO need to save FP register to specific reg on return maybe fp6 ?
                 emit("mov.d", outreg, reg);
 
@@ -1182,11 +1188,11 @@ namespace CodeGen {
             }
             else
             {
-                reg = Register::Next();
+                reg = Register::Next(arena);
                 emit("lw", reg, p->expr->mem);
-                addComment(new Comment("fill " + p->expr->memName + " to " + reg->emit() + " from " + p->expr->mem->emit()));
-                emit("move", new Register("v0"), reg);
-                addComment(new Comment("assign return value into $v0"));
+                addComment(arena.make<Comment>("fill " + p->expr->memName + " to " + reg->emit() + " from " + p->expr->mem->emit()));
+                emit("move", arena.make<Register>("v0"), reg);
+                addComment(arena.make<Comment>("assign return value into $v0"));
                 Register::Free();
             }
         }
@@ -1206,18 +1212,18 @@ namespace CodeGen {
     void CodeGenVisitor::visit(AST::If *p)
     {
         // Get Else and End Label
-        Label * elseLabel = Label::Next();
-        Label * endLabel = Label::Next();
+        Label * elseLabel = Label::Next(arena);
+        Label * endLabel = Label::Next(arena);
 
         if (p->elseStmt == nullptr)
             elseLabel = endLabel;
 
         // Get reg to hold conditional value
-        Register *reg = Register::Next();
+        Register *reg = Register::Next(arena);
 
         p->expr->accept(this);
 
-        emit(new Comment("IfZ " + p->expr->memName + " Goto " + elseLabel->emit()));
+        emit(arena.make<Comment>("IfZ " + p->expr->memName + " Goto " + elseLabel->emit()));
 
         emit("lw", reg, p->expr->mem);
         emit("beqz", reg, elseLabel);
@@ -1231,7 +1237,7 @@ namespace CodeGen {
         if (p->elseStmt != nullptr)
         {
             // only need to emit branch if else block is present
-            emit(new Comment("Goto " + endLabel->emit()));
+            emit(arena.make<Comment>("Goto " + endLabel->emit()));
             emit("b", endLabel);
             emit(elseLabel);
 
@@ -1245,18 +1251,18 @@ namespace CodeGen {
     void CodeGenVisitor::visit(AST::While *p)
     {
         // Get Start of Loop Label and End Label
-        Label *start = Label::Next();
-        endLoop = Label::Next();
+        Label *start = Label::Next(arena);
+        endLoop = Label::Next(arena);
 
         // emit start label
         emit(start);
 
         // Get reg to hold conditional value
-        Register *reg = Register::Next();
+        Register *reg = Register::Next(arena);
 
         p->expr->accept(this);
 
-        emit(new Comment("IfZ " + p->expr->memName + " Goto " + endLoop->emit()));
+        emit(arena.make<Comment>("IfZ " + p->expr->memName + " Goto " + endLoop->emit()));
 
         emit("lw", reg, p->expr->mem);
         emit("beqz", reg, endLoop);
@@ -1277,16 +1283,16 @@ namespace CodeGen {
         if (p->startExpr != nullptr)
             p->startExpr->accept(this);
 
-        Label *start = Label::Next();
-        endLoop = Label::Next();
+        Label *start = Label::Next(arena);
+        endLoop = Label::Next(arena);
 
         emit(start);
         // Get reg to hold conditional value
-        Register *reg = Register::Next();
+        Register *reg = Register::Next(arena);
 
         p->expr->accept(this);
 
-        emit(new Comment("IfZ " + p->expr->memName + " Goto " + endLoop->emit()));
+        emit(arena.make<Comment>("IfZ " + p->expr->memName + " Goto " + endLoop->emit()));
 
         emit("lw", reg, p->expr->mem);
         emit("beqz", reg, endLoop);
@@ -1323,12 +1329,12 @@ namespace CodeGen {
         ss.str("");
         ss << "_" << p->value.getValue<std::string>();
 
-        Label* l = new Label(ss.str());
+        Label* l = arena.make<Label>(ss.str());
 
-        emit(new Comment(tmp + " = " + l->emit()));
+        emit(arena.make<Comment>(tmp + " = " + l->emit()));
 
         emit("jal", l);
-        addComment(new Comment("jump to function"));
+        addComment(arena.make<Comment>("jump to function"));
 
         saveReturn(p, tmp);
 
@@ -1367,20 +1373,20 @@ namespace CodeGen {
             switch ( formal->outType )
             {
             case Scanner::Token::Type::Int :
-                l = new Label("_PrintInt");
+                l = arena.make<Label>("_PrintInt");
                 break;
             case Scanner::Token::Type::String :
-                l = new Label("_PrintString");
+                l = arena.make<Label>("_PrintString");
                 break;
             case Scanner::Token::Type::Bool :
-                l = new Label("_PrintBool");
+                l = arena.make<Label>("_PrintBool");
             default:
                 break;
             }
 
-            emit(new Comment("LCall " + l->label));
+            emit(arena.make<Comment>("LCall " + l->label));
             emit("jal", l);
-            addComment(new Comment("jump to function"));
+            addComment(arena.make<Comment>("jump to function"));
 
             // now we need to pop params
             popParams(1);
@@ -1393,12 +1399,12 @@ namespace CodeGen {
         std::stringstream ss;
         ss << "_tmp" << tmpCounter++;
 
-        Label* l = new Label("_ReadLine");
+        Label* l = arena.make<Label>("_ReadLine");
 
-        emit(new Comment(ss.str() + " = " + l->emit()));
+        emit(arena.make<Comment>(ss.str() + " = " + l->emit()));
 
         emit("jal", l);
-        addComment(new Comment("jump to function"));
+        addComment(arena.make<Comment>("jump to function"));
 
         saveReturn(p, ss.str());
     }
@@ -1408,12 +1414,12 @@ namespace CodeGen {
         std::stringstream ss;
         ss << "_tmp" << tmpCounter++;
 
-        Label* l = new Label("_ReadInteger");
+        Label* l = arena.make<Label>("_ReadInteger");
 
-        emit(new Comment(ss.str() + " = " + l->emit()));
+        emit(arena.make<Comment>(ss.str() + " = " + l->emit()));
 
         emit("jal", l);
-        addComment(new Comment("jump to function"));
+        addComment(arena.make<Comment>("jump to function"));
 
         saveReturn(p, ss.str());
 
@@ -1427,7 +1433,7 @@ namespace CodeGen {
      */
     void CodeGenVisitor::visit(AST::Declaration *p)
     {
-        SymbolTable::IdEntry* e= p->pScope->idLookup(p->ident.getValue<std::string>());
+        SymbolTable::IdEntry* e= p->pScope->idLookup(p->ident.symbol());
 
         if (e == nullptr)
             throw std::runtime_error("No declaration found for identifier: " + p->ident.getValue<std::string>());
@@ -1491,10 +1497,10 @@ namespace CodeGen {
         std::string funcName = p->ident.getValue<std::string>();
         // std::cout << "Staring gen of function: " << p->ident.getValue<std::string>() << std::endl;
 
-        if (funcName.compare("main") == 0)
-            emit(new Label(funcName));
+        if (p->ident.symbol() == Scanner::Symbols::Main)
+            emit(arena.make<Label>(funcName));
         else
-            emit(new Label("_" + funcName));
+            emit(arena.make<Label>("_" + funcName));
 
         // TODO figure out how to insert ref to offset size here
         emit("BeginFunc ", &(p->pScope->baseOffset) );
@@ -1503,17 +1509,17 @@ namespace CodeGen {
 
         // setup frame
 
-        emit("subu", new Register("sp"), new Register("sp"), new Immediate("8"));
-        instructions.back()->comment = new Comment("decrement sp to make space to save ra, fp");
+        emit("subu", arena.make<Register>("sp"), arena.make<Register>("sp"), arena.make<Immediate>("8"));
+        instructions.back()->comment = arena.make<Comment>("decrement sp to make space to save ra, fp");
 
-        emit("sw", new Register("fp"), new Memory("sp", 8));
-        instructions.back()->comment = new Comment("save fp");
+        emit("sw", arena.make<Register>("fp"), arena.make<Memory>("sp", 8));
+        instructions.back()->comment = arena.make<Comment>("save fp");
 
-        emit("sw", new Register("ra"), new Memory("sp", 4));
-        instructions.back()->comment = new Comment("save ra");
+        emit("sw", arena.make<Register>("ra"), arena.make<Memory>("sp", 4));
+        instructions.back()->comment = arena.make<Comment>("save ra");
 
-        emit("addiu", new Register("fp"), new Register("sp"), new Immediate("8"));
-        instructions.back()->comment = new Comment("set up new fp");
+        emit("addiu", arena.make<Register>("fp"), arena.make<Register>("sp"), arena.make<Immediate>("8"));
+        instructions.back()->comment = arena.make<Comment>("set up new fp");
 
         // visit declarations to generate offsets for parameters (not needed in main)
 
@@ -1525,14 +1531,14 @@ namespace CodeGen {
         // get ref to current scopes space offset, this will be used later for instr
         //  output
         // TODO @ccs need to make Immediate value / location a ref so it's modifiable
-        emit("subu", new Register("sp"), new Register("sp"), new Immediate(&(p->pScope->baseOffset)));
-        instructions.back()->comment = new Comment("decrement sp to make space for locals/temps");
+        emit("subu", arena.make<Register>("sp"), arena.make<Register>("sp"), arena.make<Immediate>(&(p->pScope->baseOffset)));
+        instructions.back()->comment = arena.make<Comment>("decrement sp to make space for locals/temps");
 
         emit("End frame setup");
 
         // generate sub expression
         emit("Statement Body");
-        p->stmts->accept(this);
+        p->body()->accept(this);
 
 
         // return from function
@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include <common/Arena.hpp>
+#include <common/Diagnostics.hpp>
 #include <visitor/astVisitor.hpp>
 #include <AST/AbstractSyntaxTree.hpp>
 
@@ -9,12 +11,17 @@
 
 
 namespace CodeGen {
-    void generate(AST::Program *p, std::string file_name);
+    // false (and nothing written) if an error was reported, instructions
+    // and locations are made in arena
+    bool generate(AST::Program *p, std::ostream &assembly, Common::Diagnostics &diagnostics, Common::Arena &arena);
     
     class CodeGenVisitor: public Visitor {
 
         public:
-            CodeGenVisitor();
+            CodeGenVisitor(Common::Diagnostics &diagnostics, Common::Arena &arena);
+
+            Common::Diagnostics &diagnostics;
+            Common::Arena &arena;
 
             int tmpCounter;
             int labelCounter;
@@ -39,7 +46,7 @@ namespace CodeGen {
 
             std::vector<InstructionStreamItems*> instructions;
 
-            void write(std::string fileName);
+            void write(std::ostream &out);
 
             // Keep references to an instance Register & Memory
             // this will allow for calls to Next() for next available register and
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <string>
+
+#include <common/Arena.hpp>
+#include <common/Casting.hpp>
     
 namespace CodeGen {
     /**
@@ -43,7 +46,7 @@ namespace CodeGen {
             std::string name;   //holds the name of the register (t1-tN) (fp, sp, gb, ...)
             std::string emit();
 
-            static Register* Next();
+            static Register* Next(Common::Arena &arena);
             static void Free();
 
     };
@@ -58,7 +61,7 @@ namespace CodeGen {
             std::string name;   //holds the name of the register (t1-tN) (fp, sp, gb, ...)
             std::string emit();
 
-            static FloatingRegister* Next();
+            static FloatingRegister* Next(Common::Arena &arena);
             static void Free();
     };
 
@@ -78,14 +81,29 @@ namespace CodeGen {
 
     class Comment;
     class InstructionStreamItems {
+        public:
+            // what the item is, for Common::isa / dyn_cast
+            enum class Kind {
+                Comment,
+                Command,
+                Instruction,
+                Label
+            };
+
         protected:
-            InstructionStreamItems() 
+            InstructionStreamItems(Kind kind) 
                 : comment(nullptr)
+                , itemKind(kind)
             {};
 
         public:
+            Kind kind() const { return itemKind; };
+
             virtual std::string emit() = 0;
             Comment *comment;   //optionally comment to follow instruction
+
+        private:
+            Kind itemKind;
     };
 
     /**
@@ -105,6 +123,8 @@ namespace CodeGen {
             int *dataSize;
 
             std::string emit();
+
+            static bool classof(const InstructionStreamItems *item) { return item->kind() == Kind::Comment; };
     };
 
     /**
@@ -120,6 +140,8 @@ namespace CodeGen {
             std::string command;
 
             std::string emit();
+
+            static bool classof(const InstructionStreamItems *item) { return item->kind() == Kind::Command; };
     };
 
 
@@ -143,6 +165,8 @@ namespace CodeGen {
 
 
             std::string emit();
+
+            static bool classof(const InstructionStreamItems *item) { return item->kind() == Kind::Instruction; };
     };
 
     class Label :  public Location, public InstructionStreamItems {
@@ -152,10 +176,12 @@ namespace CodeGen {
             std::string label;
             std::string emit();
 
+            static bool classof(const InstructionStreamItems *item) { return item->kind() == Kind::Label; };
+
             static int counter;
             
-            static Label * Next();
-            static Label * Next(std::string info);
+            static Label * Next(Common::Arena &arena);
+            static Label * Next(Common::Arena &arena, std::string info);
     };
 
 };
\ No newline at end of file
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Common {
+    /**
+     * @brief Bump allocator for the objects of one compilation
+     *
+     *  Parse tree and AST nodes, symbol table scopes and entries and code
+     *  gen instructions and locations are made with make() and all live
+     *  until the arena is released at the end of the compilation. Nothing
+     *  made here may be deleted on its own.
+     *
+     *  Memory is taken from the system in blocks so making an object is
+     *  usually a pointer bump. Objects with destructors are chained inside
+     *  the arena as they are made and destroyed in reverse order on release,
+     *  so the strings and containers they hold are given back as well.
+     *
+     *  An arena belongs to one compilation and is not shared between threads.
+     */
+    class Arena {
+
+        public:
+            Arena(std::size_t blockSize = 64 * 1024)
+                : blockSize(blockSize)
+                , blocks(nullptr)
+                , cleanups(nullptr)
+                , next(nullptr)
+                , end(nullptr)
+                , numBlocks(0)
+            {};
+
+            Arena(const Arena &) = delete;
+            Arena& operator=(const Arena &) = delete;
+
+            ~Arena() { release(); };
+
+            template <class T, class... Args>
+            T* make(Args&&... args)
+            {
+                if constexpr (std::is_trivially_destructible_v<T>)
+                    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+                else
+                {
+                    Cleanup *cleanup = static_cast<Cleanup*>(allocate(sizeof(Cleanup), alignof(Cleanup)));
+                    T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+                    // only chained once constructed, a throwing constructor leaves nothing to destroy
+                    cleanup->destroy = [](void *p) { static_cast<T*>(p)->~T(); };
+                    cleanup->object = object;
+                    cleanup->next = cleanups;
+                    cleanups = cleanup;
+
+                    return object;
+                }
+            };
+
+            // uninitialized memory released along with the arena
+            void* allocate(std::size_t size, std::size_t alignment)
+            {
+                std::uintptr_t start = (reinterpret_cast<std::uintptr_t>(next) + alignment - 1) & ~(alignment - 1);
+
+                if (next == nullptr || start + size > reinterpret_cast<std::uintptr_t>(end))
+                {
+                    addBlock(size + alignment);
+                    start = (reinterpret_cast<std::uintptr_t>(next) + alignment - 1) & ~(alignment - 1);
+                }
+
+                next = reinterpret_cast<char*>(start + size);
+                return reinterpret_cast<void*>(start);
+            };
+
+            // destroy everything made so far and give the memory back, the arena can be used again
+            void release()
+            {
+                for (Cleanup *cleanup = cleanups; cleanup != nullptr; cleanup = cleanup->next)
+                    cleanup->destroy(cleanup->object);
+
+                while (blocks != nullptr)
+                {
+                    Block *block = blocks;
+                    blocks = block->next;
+                    ::operator delete(block);
+                }
+
+                cleanups = nullptr;
+                next = end = nullptr;
+                numBlocks = 0;
+            };
+
+            /**
+             * @brief Take over everything made in other, which is left empty
+             *
+             *  The objects stay where they are and are destroyed along with
+             *  the ones made here. Lets work done on other threads, each in
+             *  an arena of its own, end up in the arena of the compilation.
+             */
+            void adopt(Arena &other)
+            {
+                if (other.blocks == nullptr)
+                    return;
+
+                // other's blocks go behind the one being filled
+                Block *lastBlock = other.blocks;
+                while (lastBlock->next != nullptr)
+                    lastBlock = lastBlock->next;
+
+                if (blocks == nullptr)
+                {
+                    blocks = other.blocks;
+                    next = other.next;
+                    end = other.end;
+                }
+                else
+                {
+                    lastBlock->next = blocks->next;
+                    blocks->next = other.blocks;
+                }
+
+                // objects of other are chained ahead of the ones made here
+                if (other.cleanups != nullptr)
+                {
+                    Cleanup *lastCleanup = other.cleanups;
+                    while (lastCleanup->next != nullptr)
+                        lastCleanup = lastCleanup->next;
+
+                    lastCleanup->next = cleanups;
+                    cleanups = other.cleanups;
+                }
+
+                numBlocks += other.numBlocks;
+
+                other.blocks = nullptr;
+                other.cleanups = nullptr;
+                other.next = other.end = nullptr;
+                other.numBlocks = 0;
+            };
+
+            // blocks taken from the system since the last release
+            std::size_t size() const { return numBlocks; };
+
+        private:
+            struct Block {
+                Block *next;
+            };
+
+            struct Cleanup {
+                void    (*destroy)(void *);
+                void    *object;
+                Cleanup *next;
+            };
+
+            std::size_t blockSize;
+            Block       *blocks;
+            Cleanup     *cleanups;
+            char        *next;
+            char        *end;
+            std::size_t numBlocks;
+
+            // objects larger than a block get a block of their own
+            void addBlock(std::size_t minSize)
+            {
+                std::size_t bytes = sizeof(Block) + std::max(blockSize, minSize);
+                Block *block = static_cast<Block*>(::operator new(bytes));
+
+                block->next = blocks;
+                blocks = block;
+                numBlocks++;
+
+                next = reinterpret_cast<char*>(block + 1);
+                end = reinterpret_cast<char*>(block) + bytes;
+            };
+    };
+}
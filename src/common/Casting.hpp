@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cassert>
+
+namespace Common {
+    /**
+     * @brief Checked casts down a class hierarchy without RTTI
+     *
+     *  A hierarchy opts in by giving its base a kind tag set once by the
+     *  constructor of the most derived class, and every class a static
+     *  classof(const Base*) telling whether a node of that kind is one of
+     *  it. Kinds are numbered so the kinds of a class and everything below
+     *  it are one contiguous range, so classof is a compare or two.
+     *
+     *      if (AST::Ident *ident = Common::dyn_cast<AST::Ident>(node))
+     *          ...
+     *
+     *  Unlike dynamic_cast these take a non null pointer, dyn_cast_or_null
+     *  is there for the places null may come in.
+     */
+
+    template <class To, class From>
+    bool isa(const From *from)
+    {
+        return To::classof(from);
+    }
+
+    // from is known to be a To, only checked in debug builds
+    template <class To, class From>
+    To* cast(From *from)
+    {
+        assert(isa<To>(from) && "cast to a class the node is not");
+        return static_cast<To*>(from);
+    }
+
+    template <class To, class From>
+    To* dyn_cast(From *from)
+    {
+        return isa<To>(from) ? static_cast<To*>(from) : nullptr;
+    }
+
+    template <class To, class From>
+    To* dyn_cast_or_null(From *from)
+    {
+        return (from != nullptr) ? dyn_cast<To>(from) : nullptr;
+    }
+}
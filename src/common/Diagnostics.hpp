@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Common {
+    /**
+     * @brief Errors reported by every stage of one compilation
+     *
+     *  Each message is the exact text the command line prints, kept with the
+     *  stage and line it came from. Messages are also written to the output
+     *  stream as they are reported so they stay in order with the rest of the
+     *  output (parse tree, token dump).
+     */
+    class Diagnostics {
+
+        public:
+            enum class Stage : std::uint8_t {
+                Lexer,
+                Parser,
+                SymbolTable,
+                Semantic,
+                Linker,
+                CodeGen,
+            };
+
+            struct Entry {
+                Stage       stage;
+                int         lineNumber;     // 0 when not tied to a line
+                std::string message;
+            };
+
+            Diagnostics(std::ostream &out)
+                : out(out)
+                , list()
+            {};
+
+            void report(Stage stage, int lineNumber, std::string message)
+            {
+                out << message;
+                list.push_back( {stage, lineNumber, std::move(message)} );
+            };
+
+            // keep a message the caller has already written out itself
+            void record(Stage stage, int lineNumber, std::string message)
+            {
+                list.push_back( {stage, lineNumber, std::move(message)} );
+            };
+
+            // where non diagnostic output of the stages goes
+            std::ostream & output() { return out; };
+
+            const std::vector<Entry> & entries() const { return list; };
+            bool empty() const { return list.empty(); };
+
+        private:
+            std::ostream        &out;
+            std::vector<Entry>  list;
+    };
+}
@@ -0,0 +1,314 @@
+#include "compile.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <common/Arena.hpp>
+
+#include <lexer/lexer.hpp>
+#include <lexer/exceptions.hpp>
+#include <token/writer.hpp>
+
+#include <parser/TreeGeneration.hpp>
+#include <parser/ParseTreePrinter.hpp>
+#include <parser/exceptions.hpp>
+
+#include <AST/AbstractSyntaxTree.hpp>
+#include <AST/ASTGeneration.hpp>
+#include <AST/ParseTreeVisitor.hpp>
+
+#include <SymbolTable/generate.hpp>
+#include <semantic-analyzer/STTypeVisitor.hpp>
+
+#include <code-gen/CodeGenVisitor.hpp>
+
+namespace Decaf {
+
+    using Stage = Common::Diagnostics::Stage;
+
+    namespace {
+        // sources at least this large have their function bodies parsed on
+        // every core, smaller ones parse faster as the lexer goes
+        constexpr std::size_t parallelParseSize = 256 << 10;
+
+        // convert file to tokens in one pass, then print them with any
+        // errors in between
+        void dumpTokens(Scanner::Lexer &lexer, Common::Diagnostics &diagnostics)
+        {
+            const Scanner::TokenStore &tokens = lexer.tokenizeAll();
+            const std::vector<Scanner::Lexer::Diagnostic> &errors = lexer.diagnostics();
+            auto error = errors.begin();
+            Scanner::TokenWriter writer(diagnostics.output());
+
+            for (std::uint32_t i = 0; i < tokens.size(); i++)
+            {
+                for (; error != errors.end() && error->before == i; error++)
+                {
+                    writer.write(error->message);
+                    writer.write('\n');
+                    diagnostics.record(Stage::Lexer, error->lineNumber, error->message + "\n");
+                }
+
+                Scanner::Token token = tokens[i];
+                writer.write(token);
+
+                if (token.type() == Scanner::Token::Type::ERROR)
+                    diagnostics.record(Stage::Lexer, token.lineNumber(), Scanner::tokenError(token).what());
+            }
+
+            for (; error != errors.end(); error++)
+            {
+                writer.write(error->message);
+                writer.write('\n');
+                diagnostics.record(Stage::Lexer, error->lineNumber, error->message + "\n");
+            }
+
+            writer.flush();
+            diagnostics.output().flush();
+        }
+
+        // messages the lexer kept while the parser pulled tokens
+        void reportLexer(Scanner::Lexer &lexer, Common::Diagnostics &diagnostics)
+        {
+            for (const Scanner::Lexer::Diagnostic &error : lexer.diagnostics())
+                diagnostics.report(Stage::Lexer, error.lineNumber, error.message + "\n");
+        }
+
+        std::string_view typeName(Scanner::Token::Type type)
+        {
+            switch(type)
+            {
+                case Scanner::Token::Type::Int:     return "int";
+                case Scanner::Token::Type::Void:    return "void";
+                case Scanner::Token::Type::Bool:    return "bool";
+                case Scanner::Token::Type::Double:  return "double";
+                case Scanner::Token::Type::String:  return "string";
+                default:                            return Scanner::Token::enumName[static_cast<int>(type)];
+            }
+        }
+
+        // a line for each global variable and function in source order, with
+        // its line number, type, name and the parameters of functions
+        void printSignatures(AST::Program *prog, std::ostream &out)
+        {
+            std::vector<AST::Declaration*> decls(prog->vars.begin(), prog->vars.end());
+
+            for (AST::Node *node : prog->func)
+                decls.push_back(Common::cast<AST::Declaration>(node));
+
+            std::sort(decls.begin(), decls.end(), [](AST::Declaration *a, AST::Declaration *b) {
+                return a->ident.lineNumber() != b->ident.lineNumber() ?
+                    a->ident.lineNumber() < b->ident.lineNumber() :
+                    a->ident.colStart() < b->ident.colStart();
+            });
+
+            for (AST::Declaration *decl : decls)
+            {
+                out << std::setw(3) << decl->ident.lineNumber() << " "
+                    << typeName(decl->type) << " " << decl->ident.getValue<std::string>();
+
+                if (AST::FunctionDeclaration *func = Common::dyn_cast<AST::FunctionDeclaration>(decl))
+                {
+                    out << "(";
+
+                    for (std::size_t i = 0; i < func->formals.size(); i++)
+                    {
+                        out << ((i > 0) ? ", " : "") << typeName(func->formals[i]->type)
+                            << " " << func->formals[i]->ident.getValue<std::string>();
+                    }
+
+                    out << ")";
+                }
+
+                out << "\n";
+            }
+
+            out.flush();
+        }
+
+        // syntax errors kept while recovering, in the order they were found
+        void reportParser(std::vector<Parser::ParseException> &errors, Common::Diagnostics &diagnostics)
+        {
+            for (Parser::ParseException &error : errors)
+                diagnostics.report(Stage::Parser, error.lineNumber, std::string(error.what()) + "\n");
+        }
+
+        // run the stages after lexing, returns false when an error stops them,
+        // function bodies are parsed on parseThreads threads when not recovering
+        bool translate(Scanner::Lexer &lexer, Mode mode, bool recover, unsigned parseThreads,
+                       Common::Diagnostics &diagnostics, std::string &assembly)
+        {
+            std::ostream &out = diagnostics.output();
+
+            // lexer messages are printed once parsing is over, the parse tree
+            // follows them
+            lexer.keepDiagnostics(true);
+
+            // trees, symbol tables and instructions of this compile, all
+            // released on return
+            Common::Arena arena;
+
+            // only --parser prints the parse tree, --syntax-only builds
+            // nothing, --signatures leaves function bodies unparsed and the
+            // other modes parse straight to the AST
+            Parser::Program *tree = nullptr;
+            AST::Program *prog = nullptr;
+
+            // syntax errors recovered from, printed together once parsing ends
+            std::vector<Parser::ParseException> syntaxErrors;
+            std::vector<Parser::ParseException> *errors = recover ? &syntaxErrors : nullptr;
+
+            bool parallel = ! recover && parseThreads > 1;
+
+            try {
+                if (mode == Mode::SyntaxOnly && parallel)
+                    Parser::parallelSyntaxCheck(&lexer, parseThreads);
+                else if (mode == Mode::SyntaxOnly)
+                    Parser::syntaxCheck(&lexer, errors);
+                else if (mode == Mode::Signatures)
+                    prog = AST::signatureGeneration(&lexer, arena);
+                else if (mode == Mode::Parser && parallel)
+                    tree = Parser::parallelTreeGeneration(&lexer, arena, parseThreads);
+                else if (mode == Mode::Parser)
+                    tree = Parser::treeGeneration(&lexer, arena, errors);
+                else if (parallel)
+                    prog = AST::parallelAstGeneration(&lexer, arena, parseThreads);
+                else
+                    prog = AST::astGeneration(&lexer, arena, errors);
+            }
+            catch ( Scanner::GenericException &exc )
+            {
+                reportLexer(lexer, diagnostics);
+                reportParser(syntaxErrors, diagnostics);
+                diagnostics.report(Stage::Lexer, exc.lineNumber, std::string(exc.what()) + "\n");
+                return false;
+            }
+            catch ( Parser::ParseException &exc )
+            {
+                reportLexer(lexer, diagnostics);
+                diagnostics.report(Stage::Parser, exc.lineNumber, std::string(exc.what()) + "\n");
+                return false;
+            }
+            // anything else the parse gives up on is still this compile's error,
+            // not the caller's
+            catch ( std::runtime_error &exc )
+            {
+                reportLexer(lexer, diagnostics);
+                reportParser(syntaxErrors, diagnostics);
+                diagnostics.report(Stage::Parser, 0, std::string(exc.what()) + "\n");
+                return false;
+            }
+
+            reportLexer(lexer, diagnostics);
+
+            if (! syntaxErrors.empty())
+            {
+                reportParser(syntaxErrors, diagnostics);
+                return false;
+            }
+
+            if (mode == Mode::SyntaxOnly)
+                return true;
+
+            if (mode == Mode::Parser)
+            {
+                out << std::endl;
+
+                Parser::ParseTreePrinter printer(out);
+                printer.print(tree);
+            }
+
+            try {
+                // convert parse tree to AST
+                if (prog == nullptr)
+                    prog = AST::convert(tree, arena);
+
+                if (mode == Mode::Signatures)
+                    SymbolTable::generateGlobals(prog, arena);
+                else
+                    SymbolTable::generate(prog, arena);
+            }
+            catch ( Parser::ParseException &exc )
+            {
+                diagnostics.report(Stage::Parser, exc.lineNumber, std::string(exc.what()) + "\n");
+                return false;
+            }
+            catch ( SymbolTable::Exception &exc )
+            {
+                diagnostics.report(Stage::SymbolTable, exc.lineNumber, std::string(exc.what()) + "\n");
+                return false;
+            }
+
+            if (mode == Mode::Parser)
+                return true;
+
+            if (mode == Mode::Signatures)
+            {
+                printSignatures(prog, out);
+                return true;
+            }
+
+            bool bTypeCheck(true);
+            try {
+                bTypeCheck = SemanticAnalyzer::typeCheck(prog, diagnostics);
+            }
+            // Some Semantic checking can be "recoverable or at least ignore later invocations of issues"
+            catch ( std::exception &exc )
+            {
+                diagnostics.report(Stage::Semantic, 0, std::string(exc.what()) + "\n");
+                return false;
+            }
+
+            // stop after semantic checking
+            if (mode == Mode::SemanticCheck)
+                return true;
+
+            //linking stage
+            if (bTypeCheck && prog->pScope->idLookup(Scanner::Symbols::Main) == nullptr)
+            {
+                diagnostics.report(Stage::Linker, 0, "\n*** Error.\n*** Linker: function 'main' not defined\n\n");
+                return false;
+            }
+
+            // code gen
+            if (bTypeCheck)
+            {
+                std::ostringstream program;
+
+                if (CodeGen::generate(prog, program, diagnostics, arena))
+                    assembly = program.str();
+            }
+
+            return true;
+        }
+    }
+
+    Result compile(std::string_view source, const Options &options)
+    {
+        std::ostringstream captured;
+        Common::Diagnostics diagnostics(options.output != nullptr ? *options.output : captured);
+        Scanner::Lexer lexer(source.data(), source.data() + source.size());
+
+        Result result{};
+
+        if (options.mode == Mode::Lexer)
+            dumpTokens(lexer, diagnostics);
+        else
+        {
+            unsigned parseThreads = (source.size() >= parallelParseSize) ? std::thread::hardware_concurrency() : 1;
+
+            result.stopped = ! translate(lexer, options.mode, options.recover, parseThreads, diagnostics, result.assembly);
+        }
+
+        result.success = diagnostics.empty() && ! result.stopped;
+        result.diagnostics = diagnostics.entries();
+
+        if (options.output == nullptr)
+            result.output = captured.str();
+
+        return result;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <common/Diagnostics.hpp>
+
+namespace Decaf {
+    // how far to take the source, one per command line function
+    enum class Mode {
+        Lexer,
+        SyntaxOnly,
+        Signatures,     // global symbol table from the declarations alone
+        Parser,
+        SemanticCheck,
+        CodeGen,
+    };
+
+    struct Options {
+        Mode mode = Mode::CodeGen;
+
+        // carry on past syntax errors and report all of them together, the
+        // stages after parsing only run when there are none
+        bool recover = false;
+
+        // where the token dump, parse tree and error messages are written as
+        // they are produced, they are kept in Result::output when null
+        std::ostream *output = nullptr;
+    };
+
+    using Diagnostic = Common::Diagnostics::Entry;
+
+    struct Result {
+        bool success;       // nothing was reported
+        bool stopped;       // an error ended compilation before the mode finished
+
+        std::string output;     // printed text, empty when Options::output is set
+        std::string assembly;   // generated program, empty unless code gen ran
+
+        std::vector<Diagnostic> diagnostics;
+    };
+
+    /**
+     * @brief Compile source held in memory
+     *
+     *  Runs the same stages as the command line does for mode and prints the
+     *  same text, nothing is read from or written to the filesystem. Every
+     *  call is independent so the same source compiles to the same assembly
+     *  each time.
+     *
+     * @param source program text, only read during the call
+     * @param options
+     * @return Result
+     */
+    Result compile(std::string_view source, const Options &options = Options());
+}
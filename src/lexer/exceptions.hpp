@@ -2,6 +2,7 @@
 
 #include <exception>
 #include <string>
+#include <sstream>
 
 #include "token/token.hpp"
 
@@ -10,11 +11,14 @@ namespace Scanner {
         std::string message;
         
         public:
+        int lineNumber = 0;
+
         GenericException(char * msg) : 
             message(msg)
         {};
 
         GenericException(const int lineNumber, std::string msg )
+            : lineNumber(lineNumber)
         {
             std::stringstream ss;
             ss << "\n*** Error line " << lineNumber << "." << std::endl;
@@ -57,4 +61,18 @@ namespace Scanner {
 
         };
     };
+
+    /**
+     * @brief Exception an ERROR token stands for
+     *
+     *  Lets callers that stop at the first lexical error raise it, or print
+     *  the same message.
+     */
+    inline GenericException tokenError(const Token &token)
+    {
+        if (token.error() == Token::Error::UnterminatedString)
+            return UnterminatedString(token.lineNumber(), std::string(token.value()));
+
+        return UnrecognizedCharacter(token.lineNumber(), std::string(token.value()));
+    }
 }
\ No newline at end of file
@@ -1,20 +1,42 @@
-#include <regex>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
+#include <memory>
 
 
 #include "lexer.hpp"
 #include "predicates.hpp"
+#include "scan.hpp"
 #include "exceptions.hpp"
 
 
 void Scanner::Lexer::nextLine()
 {
-    std::string tmp;
-    std::getline(sourceFile, tmp);
-    lineStream.str(tmp);
-    lineStream.clear();
+    const char *end = source.end();
+    const char *newLine = static_cast<const char*>(
+        (fileCursor < end) ? std::memchr(fileCursor, '\n', end - fileCursor) : nullptr
+    );
 
-    //std::cout << "Getting line[" << lineNumber << "]: " << lineStream.str() << std::endl;
+    lineStart = fileCursor;
+    lines.addLine(lineStart - source.begin());
+
+    if (newLine != nullptr)
+    {
+        lineEnd = newLine;
+        fileCursor = newLine + 1;
+    }
+    else
+    {
+        // last line has no trailing new line (or there is nothing left)
+        lineEnd = end;
+        fileCursor = end;
+        sourceEof = true;
+    }
+
+    cursor = lineStart;
+
+    //std::cout << "Getting line[" << lineNumber << "]: " << std::string(lineStart, lineEnd) << std::endl;
 
     // increment line number
     lineNumber++;
@@ -24,337 +46,593 @@ void Scanner::Lexer::nextLine()
 
 /**
  * @brief Helper function to eat whitespace before token reading
- * 
+ *
  */
 void Scanner::Lexer::skipWhiteSpace()
 {
-    std::string spaceChars(" \t\n");
-    char incomingChar;
-
-    lineStream.get(incomingChar);
-    // std::cout << "Attempting to take whitespace out..." << std::endl;
-    // std::cout << "Starting character: " << incomingChar << std::endl;
-    
-    // TODO : This does not eat space characters only tabs and newlines
-    while (spaceChars.find(incomingChar) != std::string::npos)
+    skipTo(Scan::skipWhiteSpace(cursor, lineEnd));
+}
+
+/**
+ * @brief Skip ahead of a token to end, found by one of the scan kernels
+ *
+ *  Updates the column and the skipped text the same way takeWhile would,
+ *  including consuming a NUL the run stopped on.
+ */
+void Scanner::Lexer::skipTo(const char *end)
+{
+    if (end != cursor)
+    {
+        columnNumber += end - cursor;
+        skippedLength += end - cursor;
+        skippedBack = end[-1];
+        cursor = end;
+    }
+
+    if (cursor < lineEnd && *cursor == '\0')
+        cursor++;
+}
+
+bool Scanner::Lexer::skipComments(bool atLineStart)
+{
+    // comments must start with '/'
+    if (cursor == lineEnd || *cursor != '/')
+    {
+        return false;
+    }
+
+    // check single line comment
+    if (cursor + 1 < lineEnd && cursor[1] == '/')
+    {
+        // skip line and return
+        cursor = lineEnd;
+        return true;
+    }
+    // possible multi line comment must take as many characters until hit end
+    else if (cursor + 1 < lineEnd && cursor[1] == '*')
+    {
+        // get start out of line
+        skippedLength++;
+        skippedBack = '/';
+        cursor += 2;
+        columnNumber += 2;
+
+        skipBlockComment('*', atLineStart, false);
+        return false;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Take the body of a block comment whose opening has been skipped
+ *
+ *  last is the character taken before the current one. When resuming, the
+ *  comment was left open at the end of the previous chunk and picks up from
+ *  the read of the next line.
+ */
+void Scanner::Lexer::skipBlockComment(char last, bool atLineStart, bool resuming)
+{
+    char tmp = last;
+
+    if (resuming)
     {
-        lineStream.get(incomingChar);
+        nextLine();
+
+        skipTo(Scan::find(cursor, lineEnd, '/'));
+        if (cursor < lineEnd)
+            tmp = *cursor++;
+        columnNumber++;
     }
 
-    // whichever character was taken from string that broke loop needs to be put back
-    // lineStream.clear();
-    lineStream.putback(incomingChar);
-    // std::cout << "Putting character back: " << incomingChar << std::endl;
-    // std::cout << "Line is now: " << lineStream.str() << std::endl;
+    // keep taking until hit */, the '*' has to be the last character skipped before
+    // a '/' (a line ending in '*' also counts since the '/' read then fails)
+    while (skippedBack != '*' || skippedLength < 3)
+    {
+        skippedLength++;
+        skippedBack = tmp;
+
+        // if we are at the end of the line but haven't found the end then get next line
+        if (cursor == lineEnd)
+        {
+            // unterminated comment, nothing left to take (a chunk lexer hands
+            // it on to the next chunk)
+            if (sourceEof)
+            {
+                openComment = {true, atLineStart, skippedLength, skippedBack, tmp};
+                break;
+            }
+
+            nextLine();
+        }
 
-    // reduce to loop
-    
+        // take until we hit '/', but if we hit / and it's not preceded by * then continue
+        skipTo(Scan::find(cursor, lineEnd, '/'));
 
+        // get previous /
+        if (cursor < lineEnd)
+            tmp = *cursor++;
+        columnNumber++;
+    }
+
+    skippedLength = 0;
 }
 
-bool Scanner::Lexer::skipComments()
+/**
+ * @brief Finish the comment a chunk starts inside of
+ *
+ *  Leaves the lexer as skipComments would have where the comment was
+ *  opened, either in the blank line skip or after the whitespace ahead of a
+ *  token.
+ *
+ * @return true if the next token starts right at the cursor
+ */
+bool Scanner::Lexer::resumeComment()
 {
+    CommentState state = pendingComment;
+    pendingComment.open = false;
 
-    char commentStart = lineStream.peek();
+    skippedLength = state.skippedLength;
+    skippedBack = state.skippedBack;
+    skipBlockComment(state.last, state.atLineStart, true);
+
+    if (state.atLineStart)
+        return false;
 
-    // comments must start with '\' 
-    if (commentStart != '/' || commentStart == -1) 
+    if (cursor == lineEnd)
     {
-        // std::cout << "line/character stream not starting with / exitiing" << std::endl;
+        nextLine();
         return false;
     }
+
+    return true;
+}
+
+void Scanner::Lexer::startToken(const char *start)
+{
+    tokenStart = start;
+    tokenEnd = start + 1;
+    tokenSpliced = false;
+}
+
+/**
+ * @brief Add [from, to) to the token buffer
+ *
+ *  Token text stays a view into the source as long as the pieces are
+ *  adjacent, only a NUL swallowed mid token forces a copy.
+ */
+void Scanner::Lexer::appendToken(const char *from, const char *to)
+{
+    if (from == to)
+        return;
+
+    if (!tokenSpliced && from == tokenEnd)
+    {
+        tokenEnd = to;
+        return;
+    }
+
+    if (!tokenSpliced)
+    {
+        tokenSplice.assign(tokenStart, tokenEnd);
+        tokenSpliced = true;
+    }
+
+    tokenSplice.append(from, to);
+}
+
+std::string_view Scanner::Lexer::tokenText()
+{
+    if (!tokenSpliced)
+        return std::string_view(tokenStart, tokenEnd - tokenStart);
+
+    return tokenSplice;
+}
+
+void Scanner::Lexer::report(std::string message)
+{
+    if (collecting)
+        diagnosticList.push_back( {static_cast<std::uint32_t>(tokens.size()), lineNumber, message} );
     else
+        std::cout << message << std::endl;
+}
+
+void Scanner::Lexer::dropDiagnostics(std::uint32_t numTokens)
+{
+    while (!diagnosticList.empty() && diagnosticList.back().before >= numTokens)
+        diagnosticList.pop_back();
+}
+
+void Scanner::Lexer::setParallelism(unsigned numThreads, std::size_t minSize)
+{
+    this->numThreads = numThreads;
+    parallelMinSize = minSize;
+}
+
+void Scanner::Lexer::lexRemaining()
+{
+    while (getNextToken().type() != Token::Type::END)
     {
+    }
+}
 
-        char tmp;
-        lineStream.get(tmp);
+const Scanner::TokenStore & Scanner::Lexer::tokenizeAll()
+{
+    bool untouched = tokens.size() == 0 && lineNumber == 0 && diagnosticList.empty();
+    bool wasCollecting = collecting;
 
-        // check single line comment
-        if (lineStream.peek() == '/')
-        {
-            // skip line and return
-            lineStream.str("");
-            return true;
-        }
-        // possible multi line comment must take as many characters until hit end
-        else if (lineStream.peek() == '*')
-        {
-            // get start out of stream
-            tokenBuffer << tmp;
-            lineStream.get(tmp);
-            columnNumber+=2;
+    collecting = true;
 
-            // keep taking until hit */
-            while (tokenBuffer.str().back() != '*' || tokenBuffer.str().length() < 3)
+    if (!(untouched && numThreads > 1 && source.size() >= parallelMinSize && tokenizeParallel()))
+    {
+        // decaf averages well over 4 source bytes per token, reserve so the
+        // columns are not regrown mid file
+        tokens.reserve(tokens.size() + source.size() / 4 + 1);
+
+        lexRemaining();
+    }
+
+    collecting = wasCollecting;
+
+    return tokens;
+}
+
+/**
+ * @brief Lex the whole source as chunks of lines on numThreads threads
+ *
+ *  Chunks only start on lines that begin a token, so the only state one
+ *  chunk can leave to the next is an open block comment (strings end with
+ *  their line). Every chunk is first lexed as if no comment were open, then
+ *  chunks following one that ended inside a comment are lexed again, in
+ *  order, continuing it.
+ *
+ * @return false if the source has too few lines to split
+ */
+bool Scanner::Lexer::tokenizeParallel()
+{
+    const char *begin = source.begin();
+    const char *end = source.end();
+    std::size_t numChunks = std::size_t(numThreads) * 4;
+
+    // a chunk may start at a line whose first character can't continue
+    // whitespace, a comment or a NUL skipped ahead of it
+    std::vector<const char *> starts = { begin };
+    for (std::size_t i = 1; i < numChunks; i++)
+    {
+        const char *at = std::max(begin + source.size() / numChunks * i, starts.back());
+
+        while (at < end)
+        {
+            const char *newLine = static_cast<const char*>(std::memchr(at, '\n', end - at));
+            if (newLine == nullptr || newLine + 1 == end)
             {
-                tokenBuffer << tmp;
-                // if we are at the end of the line but haven't found the end then get next line
-                if (lineStream.peek() == -1 && !sourceFile.eof())
-                {
-                    nextLine();
-                }
-                // take until we hit '/', but if we hit / and it's not preceded by * then continue
-                takeWhile(isNotCommentEnd());
-                // get previous /
-                lineStream.get(tmp);
-                columnNumber++;
+                at = end;
+                break;
             }
 
-            tokenBuffer << tmp;
-            
-            // std::cout << "Found comment: " << tokenBuffer.str() << std::endl;
-            tokenBuffer.str("");
-            return false;
-        }
-        else {
-            // clear error state before pushing back
-            if (lineStream.peek() == -1)
-                lineStream.clear();
-            lineStream.putback(tmp);
+            at = newLine + 1;
+            if (!CharClass::is(*at, CharClass::WhiteSpace) && *at != '/' && *at != '\0')
+                break;
         }
 
+        if (at == end)
+            break;
+
+        starts.push_back(at);
+    }
+
+    if (starts.size() < 2)
         return false;
+
+    // each chunk ends ahead of the new line leading into the next
+    numChunks = starts.size();
+    std::vector<const char *> ends(starts.begin() + 1, starts.end());
+    for (const char *&chunkEnd : ends)
+        chunkEnd--;
+    ends.push_back(end);
+
+    auto forEachChunk = [&](auto work) {
+        std::atomic<std::size_t> next(0);
+        std::vector<std::thread> workers;
+
+        for (unsigned t = 0; t < std::min<std::size_t>(numThreads, numChunks); t++)
+        {
+            workers.emplace_back([&]() {
+                for (std::size_t k; (k = next++) < numChunks; )
+                    work(k);
+            });
+        }
+
+        for (std::thread &worker : workers)
+            worker.join();
+    };
+
+    // line numbers carry on from one chunk to the next
+    std::vector<int> firstLines(numChunks + 1, 0);
+    forEachChunk([&](std::size_t k) {
+        firstLines[k + 1] = std::count(starts[k], ends[k], '\n') + 1;
+    });
+    for (std::size_t k = 0; k < numChunks; k++)
+        firstLines[k + 1] += firstLines[k];
+
+    std::vector<std::unique_ptr<Lexer>> chunks(numChunks);
+    auto lexChunk = [&](std::size_t k, CommentState resume) {
+        chunks[k].reset(new Lexer(starts[k], ends[k], firstLines[k], resume));
+        chunks[k]->lexRemaining();
+    };
+
+    forEachChunk([&](std::size_t k) { lexChunk(k, CommentState()); });
+
+    for (std::size_t k = 1; k < numChunks; k++)
+    {
+        if (chunks[k - 1]->openComment.open)
+            lexChunk(k, chunks[k - 1]->openComment);
+    }
+
+    // stitch chunks back into one store, text that had to be copied lives
+    // in the chunk lexer so it moves over here as well
+    std::size_t numTokens = 0;
+    for (const std::unique_ptr<Lexer> &chunk : chunks)
+        numTokens += chunk->tokens.size();
+    tokens.reserve(numTokens);
+
+    for (std::unique_ptr<Lexer> &chunk : chunks)
+    {
+        std::uint32_t base = tokens.size();
+
+        for (Diagnostic &diagnostic : chunk->diagnosticList)
+            diagnosticList.push_back( {base + diagnostic.before, diagnostic.lineNumber, std::move(diagnostic.message)} );
+
+        // chunk ids are first-seen order within the chunk, so interning its
+        // names in id order keeps ids the same as a serial lex would give
+        std::vector<SymbolId> symbolIds;
+        symbolIds.reserve(chunk->symbolPool.size());
+        for (SymbolId id = 0; id < chunk->symbolPool.size(); id++)
+            symbolIds.push_back(symbolPool.intern(chunk->symbolPool.name(id)));
+
+        tokens.append(chunk->tokens, symbolIds);
+
+        for (std::uint32_t i = base; i < tokens.size(); i++)
+        {
+            std::string_view value = tokens[i].value();
+            if (value.data() < begin || value.data() > end)
+            {
+                splicedTokens.emplace_back(value);
+                tokens.setValue(i, splicedTokens.back());
+            }
+        }
     }
 
+    lines.addLine(0);
+    for (const char *at = begin; (at = static_cast<const char*>(std::memchr(at, '\n', end - at))) != nullptr; )
+        lines.addLine(++at - begin);
+
+    // leave this lexer at the end of file, as if it had read it all itself
+    const Lexer &last = *chunks.back();
+    lineNumber = last.lineNumber;
+    columnNumber = last.columnNumber;
+    fileCursor = lineStart = lineEnd = cursor = end;
+    sourceEof = true;
+
+    return true;
 }
 
 Scanner::Token Scanner::Lexer::getNextToken()
 {
-    // set token instance now so we can early out if file is at EOF
-    Token token = Token();
-    // clear token buffer before progressing
-    tokenBuffer.str(std::string());
-
-
-    // takeWhile(isWhiteSpace());
-    // if we read new line and it's all white space/empty line then we need to go 
-    // ahead and read next line
-    // std::cout << "Testing if line is empty" << std::endl;
-    // std::cout << "ASCII value of character : " << lineStream.peek() << std::endl;
-    // lineStream.peek();
-    while( !sourceFile.eof() && (lineStream.eof() || lineStream.peek() == -1) )  {
-        // std::cout << "Empty line getting line which should be :" << std::endl;
-        nextLine();
-        // std::cout << "line [" << lineNumber << "] : " << lineStream.str() << std::endl;
-        // skipWhiteSpace();
-        takeWhile(isWhiteSpace());
-        // std::cout << "Took all whitespace checking eof : " << lineStream.eof() << std::endl;
-
-        // skip comments as well here
-        skipComments();
+    // fields of the token being built, only added to the store once complete
+    Token::Type type = Token::Type::END;
+    Token::SubType subType = Token::SubType::Operand;
+    Token::Error error = Token::Error::UnrecognizedChar;
 
-    }
+    // a chunk starting inside a comment continues it before anything else
+    bool tokenReady = pendingComment.open && resumeComment();
 
-    // early out if hit end of stream and end of file
-    if ((lineStream.peek() == -1 || lineStream.eof()) && sourceFile.eof() ) {
-        // std::cout << "Returning early since hit eof" << std::endl;
-        return token;
-        
-    }
-    // std::cout << "line [" << lineNumber << "] : " << lineStream.str() << std::endl;
-    // skip WhiteSpace here for each continued line read
-    // skipWhiteSpace();
-    takeWhile(isWhiteSpace());
-    if (skipComments() ||lineStream.peek() == -1)
+    while (!tokenReady)
     {
-        nextLine();
-        return getNextToken();
-    }
-    tokenBuffer.str("");
+        // clear skipped text before progressing
+        skippedLength = 0;
+
+        // if we read new line and it's all white space/empty line then we need to go
+        // ahead and read next line
+        while (!sourceEof && cursor == lineEnd)
+        {
+            nextLine();
+            skipWhiteSpace();
+
+            // skip comments as well here
+            skipComments(true);
+        }
 
-    // std::cout << "Starting token reading..." << std::endl;
+        // early out if hit end of line and end of file
+        if (cursor == lineEnd && sourceEof)
+        {
+            return Token();
+        }
 
+        // skip WhiteSpace here for each continued line read
+        skipWhiteSpace();
+        if (skipComments(false) || cursor == lineEnd)
+        {
+            nextLine();
+            continue;
+        }
 
+        break;
+    }
 
     // beginning of token generation
-    char tmp{ 0 };
-    lineStream.get(tmp);
+    char tmp = *cursor++;
     columnNumber++;
 
-    // std::cout << "Starting token character: " << tmp << std::endl;
-
     // find out what type of token it might be with beginning char
-    tokenBuffer << tmp;
-    token.lineNumber = lineNumber;
-    token.colStart = columnNumber;
+    std::uint16_t classes = CharClass::table[static_cast<unsigned char>(tmp)];
+    startToken(cursor - 1);
+    int colStart = columnNumber;
     // if it starts with a character its likely an identifier
-    if ( isAlpha()(tmp) )
+    if ( classes & CharClass::Alpha )
     {
-
-        token.type = Token::Type::Identifier;
-        // std::cout << "Found Identifier..." << std::endl;
+        type = Token::Type::Identifier;
 
         // take while isIdentifier
-        takeWhile(isIdentifier());
+        takeTokenWhile(isIdentifier());
 
-        // compare identifier with keywords using map
-        auto op = Token::keywords.find(tokenBuffer.str());
-        if (op != Token::keywords.end())
+        // compare identifier with keywords
+        Token::Lexeme keyword = Token::lookupKeyword(tokenText());
+        if (keyword.found)
         {
-            // std::cout << "Token string is keyword found type: " << int(op->second) << std::endl;
-            token.type = op->second;
-        } else if (tokenBuffer.str().length() > Token::identifierMaxLength)
+            type = keyword.type;
+        } else if (tokenText().length() > static_cast<std::size_t>(Token::identifierMaxLength))
         {
-            std::cout << IdentifierTooLong(lineNumber, tokenBuffer.str()).what() << std::endl;
+            report(IdentifierTooLong(lineNumber, std::string(tokenText())).what());
         }
     }
     // if it starts with a number it is either Int or DoubleConst
-    else if ( isNumber()(tmp) )
+    else if ( classes & CharClass::Number )
     {
-        token.type = Token::Type::IntConstant;
-        takeWhile(isNumber());
+        type = Token::Type::IntConstant;
+        takeTokenWhile(isNumber());
 
-        if (lineStream.peek() == '.')
+        if (cursor < lineEnd && *cursor == '.')
         {
             // possible double take period
-            lineStream.get(tmp);
-
+            const char *period = cursor++;
 
             // check to see if next char is a number or E
-            char floatTest = lineStream.peek();
+            char floatTest = (cursor < lineEnd) ? *cursor : -1;
             if (isNumber()(floatTest) || floatTest == 'E' || floatTest == 'e')
             {
                 // found double need to add to current token
                 // we took so increment column number
                 columnNumber++;
 
-                tokenBuffer << tmp; // add '.' into buffer
-                token.type = Token::Type::DoubleConstant;
+                appendToken(period, cursor); // add '.' into buffer
+                type = Token::Type::DoubleConstant;
 
                 // take all characters that are numbers
-                takeWhile(isNumber());
-                
+                takeTokenWhile(isNumber());
+
                 // get current peek since this may be E now
                 // peek will also still be the same if we no number followed decimal
-                floatTest = lineStream.peek();
+                floatTest = (cursor < lineEnd) ? *cursor : -1;
                 if (floatTest == 'E' || floatTest == 'e')
                 {
-                    // new temp 
-                    char tmp;
-                    lineStream.get(tmp);  
+                    const char *exponent = cursor++;
 
-                    floatTest = lineStream.peek();
+                    floatTest = (cursor < lineEnd) ? *cursor : -1;
                     if (isNumber()(floatTest))
                     {
                         columnNumber++;
-                        tokenBuffer << tmp; // add 'E' | 'e' into buffer
-                        takeWhile(isNumber());
+                        appendToken(exponent, cursor); // add 'E' | 'e' into buffer
+                        takeTokenWhile(isNumber());
                     }
                     else if ( floatTest == '+' || floatTest == '-')
                     {
-                        // new temp 
-                        char tmp2;
-                        lineStream.get(tmp2);  
+                        cursor++;
 
                         // we can now take the full double
-                        if (isNumber()(lineStream.peek()))
+                        if (cursor < lineEnd && isNumber()(*cursor))
                         {
                             columnNumber+= 2;
-                            tokenBuffer << tmp;
-                            tokenBuffer << tmp2;
+                            appendToken(exponent, cursor);
 
-                            takeWhile(isNumber());
+                            takeTokenWhile(isNumber());
                         }
                         // not proper double break out
-                        else 
+                        else
                         {
-                            // lineStream.clear();
-                            lineStream.putback(tmp2);
-                            lineStream.putback(tmp);
+                            cursor = exponent;
                         }
                     }
                     // not proper doulbe break out
                     else
                     {
-                        // lineStream.clear();
-                        lineStream.putback(tmp);
+                        cursor = exponent;
                     }
 
                 }
-
-                // convert to actual value now
-                // float d{0};
-                // tokenBuffer >> d;
-
-                // tokenBuffer.str(std::to_string(d));
-            } 
+            }
             else
             {
                 // put back period
-                // lineStream.clear();
-                lineStream.putback(tmp);
+                cursor = period;
             }
         }
     }
-    else if ( isOperator()(tmp) )
+    else if ( classes & CharClass::Operator )
     {
-        token.type = Token::Type::Operator;
+        Token::Lexeme op = Token::lookupOperator(std::string_view(tokenStart, 1));
 
         // need to peek to see if next character is also an operator
-        char doubleCheck = tmp;
-        tmp = lineStream.peek();
-        if ( isOperator()(tmp) ) 
+        if ( cursor < lineEnd && isOperator()(*cursor) )
         {
-            
-            std::string cmpString(tokenBuffer.str() + tmp);
-
-            // if operator exists in map insert into buffer and adjust type
-            auto op = Token::operators.find(cmpString);
-            if (op != Token::operators.end())
+            // if double operator exists insert into buffer and adjust type
+            Token::Lexeme doubleOp = Token::lookupOperator(std::string_view(tokenStart, 2));
+            if (doubleOp.found)
             {
-                // Actually get the next token out of stream
+                // Actually get the next token out of line
                 // and increment column number
                 columnNumber++;
-                lineStream.get(tmp);
-                tokenBuffer << tmp;
-                token.type = op->second;
+                cursor++;
+                appendToken(cursor - 1, cursor);
+                op = doubleOp;
             }
         }
 
-        if ( tokenBuffer.str().length() < 2 && isOnlyDoubleCharOperator()(doubleCheck) )
+        type = op.type;
+        subType = op.subType;
+
+        if ( tokenText().length() < 2 && (classes & CharClass::DoubleCharOperator) )
         {
-            throw UnrecognizedCharacter(lineNumber, tokenBuffer.str());
+            type = Token::Type::ERROR;
+            error = Token::Error::UnrecognizedChar;
         }
     }
-    else if ( isSeparator()(tmp) )
+    else if ( classes & CharClass::Separator )
     {
-        token.type = Token::Type::Separator;
+        Token::Lexeme separator = Token::lookupOperator(std::string_view(tokenStart, 1));
+
+        type = separator.type;
+        subType = separator.subType;
     }
     else if ( tmp == '\"')
     {
-        // reset string
-        // tokenBuffer.str("");
-        token.type = Token::Type::StringConstant;
+        type = Token::Type::StringConstant;
         // take while string constant
+        takeTokenWhile(isNotStringConstantEnd());
 
-        takeWhile(isNotStringConstantEnd());
-        
-        // takeWhile stops on qutoe, need to check if still in stream and consume
-        // std::cout << "Checking to see if quote still in buffer: " << char(lineStream.peek()) << std::endl;
-        if (lineStream.peek() != '\"')
+        // takeWhile stops on quote, need to check if still in line and consume
+        if (cursor == lineEnd || *cursor != '\"')
         {
-            // Throw exception with info
-            throw UnterminatedString(lineNumber, tokenBuffer.str());
+            type = Token::Type::ERROR;
+            error = Token::Error::UnterminatedString;
+        }
+        else
+        {
+            // string starts after quote increment column count
+            columnNumber++;
+            cursor++;
+            appendToken(cursor - 1, cursor);
         }
-        // string starts after quote increment column count
-        columnNumber++;
-        // std::cout << "It is so we consume it now" << std::endl;
-        lineStream.get(tmp);
-        tokenBuffer << tmp;
-        // exit(1);
     }
     else
     {
-        throw UnrecognizedCharacter(lineNumber, tokenBuffer.str());
+        type = Token::Type::ERROR;
+        error = Token::Error::UnrecognizedChar;
     }
 
-    // assign sub type if exists;
-    auto sub = Token::subTypes.find(tokenBuffer.str());
-    if (sub != Token::subTypes.end())
-        token.subType = sub->second;
+    std::string_view text = tokenText();
+    if (tokenSpliced)
+    {
+        splicedTokens.push_back(tokenSplice);
+        text = splicedTokens.back();
+    }
 
-    token.value = tokenBuffer.str();
-    token.lineInfo = lineStream.str();
+    // identifiers longer than the max are the same symbol as their truncation
+    std::uint32_t slot = Symbols::None;
+    if (type == Token::Type::Identifier)
+        slot = symbolPool.intern(text.substr(0, Token::identifierMaxLength));
+    else if (type == Token::Type::ERROR)
+        slot = static_cast<std::uint32_t>(error);
 
-    return token;
-}
\ No newline at end of file
+    return tokens.add(type, subType, text, slot, lineNumber, colStart);
+}
@@ -1,28 +1,137 @@
 #pragma once
 
 #include <string>
-#include <fstream>
-#include <sstream>
+#include <string_view>
+#include <deque>
+#include <vector>
 #include <iostream>
+#include <thread>
 
 #include <token/token.hpp>
 
+#include "source.hpp"
+
 namespace Scanner {
     class Lexer {
 
+            public:
+            /**
+             * @brief Error message to print ahead of a token in bulk mode
+             *
+             *  before is the index in the token store of the token the message
+             *  comes ahead of, equal to the store size for trailing messages.
+             */
+            struct Diagnostic {
+                std::uint32_t   before;
+                int             lineNumber;
+                std::string     message;
+            };
+
+            /**
+             * @brief Block comment left open at the end of the text being lexed
+             *
+             *  Enough of the skip state to carry on scanning the comment from
+             *  the next line, used to hand a comment from one chunk to the next
+             *  when lexing in parallel.
+             */
+            struct CommentState {
+                bool        open;
+                bool        atLineStart;    // began in the blank line skip rather than after whitespace
+                std::size_t skippedLength;
+                char        skippedBack;
+                char        last;
+            };
+
+            private:
+
             // Used to display error information
             std::string fileName;
             int lineNumber;
             int columnNumber;
 
-            // actual file
-            std::ifstream sourceFile;
+            // actual file, mapped into memory and scanned in place
+            SourceBuffer source;
+
+            // start offset of each line read so far, shared by all tokens
+            LineTable lines;
+
+            // fields of every token handed out, tokens are handles into this
+            TokenStore tokens;
+
+            // interned identifier names, token symbols are ids into this
+            Symbols symbolPool;
+
+            // start of next unread line in source
+            const char *fileCursor;
+            // set once the last line has been read (same as ifstream::eof after getline)
+            bool sourceEof;
 
-            // line stream
-            std::stringstream lineStream;
+            // current line and cursor within it, [lineStart, lineEnd)
+            const char *lineStart;
+            const char *lineEnd;
+            const char *cursor;
+
+            // token buffer, a view into source while pieces are contiguous
+            const char *tokenStart;
+            const char *tokenEnd;
+            bool        tokenSpliced;
+            std::string tokenSplice;
+
+            // storage for the rare tokens whose text is not contiguous in source
+            std::deque<std::string> splicedTokens;
+
+            // length and last character of text skipped ahead of a token, this drives
+            // where block comments are considered closed
+            std::size_t skippedLength;
+            char        skippedBack;
+
+            // set while tokenizeAll runs, messages are kept instead of printed
+            bool        collecting;
+            std::vector<Diagnostic> diagnosticList;
+
+            // comment to continue before looking for the first token, and the
+            // one left open when the end of the text was reached
+            CommentState pendingComment;
+            CommentState openComment;
+
+            // tokenizeAll splits sources of at least parallelMinSize bytes
+            // across this many threads
+            unsigned    numThreads;
+            std::size_t parallelMinSize;
+
+            // lex a chunk of a parent's source, line numbers continue from firstLine
+            Lexer(const char *begin, const char *end, int firstLine, CommentState resume) :
+                fileName(),
+                lineNumber(firstLine),
+                columnNumber(0),
+                source(begin, end),
+                lines(source.view()),
+                tokens(&lines),
+                symbolPool(),
+                fileCursor(source.begin()),
+                sourceEof(false),
+                lineStart(source.begin()),
+                lineEnd(source.begin()),
+                cursor(source.begin()),
+                tokenStart(nullptr),
+                tokenEnd(nullptr),
+                tokenSpliced(false),
+                tokenSplice(),
+                splicedTokens(),
+                skippedLength(0),
+                skippedBack('\0'),
+                collecting(true),
+                diagnosticList(),
+                pendingComment(resume),
+                openComment(),
+                numThreads(1),
+                parallelMinSize(0)
+            {
+            };
 
-            // token buffer
-            std::stringstream tokenBuffer;
+            bool resumeComment();
+            void lexRemaining();
+            bool tokenizeParallel();
 
 
             public:
@@ -30,74 +139,130 @@ namespace Scanner {
                 fileName(file_path),
                 lineNumber(0),
                 columnNumber(0),
-                sourceFile(file_path),
-                lineStream(),
-                tokenBuffer()
+                source(file_path),
+                lines(source.view()),
+                tokens(&lines),
+                symbolPool(),
+                fileCursor(source.begin()),
+                sourceEof(false),
+                lineStart(source.begin()),
+                lineEnd(source.begin()),
+                cursor(source.begin()),
+                tokenStart(nullptr),
+                tokenEnd(nullptr),
+                tokenSpliced(false),
+                tokenSplice(),
+                splicedTokens(),
+                skippedLength(0),
+                skippedBack('\0'),
+                collecting(false),
+                diagnosticList(),
+                pendingComment(),
+                openComment(),
+                numThreads(std::thread::hardware_concurrency()),
+                parallelMinSize(4 << 20)
             {
-                // Throw if source is bad so we dont lock up reading
-                // non-existant file
-                if (!sourceFile.good())
-                    throw std::invalid_argument("Invalid source file");
-
-                // go ahead and read first line into buffer
-                // nextLine();
+            };
 
+            // lex text owned by the caller, it must outlive the lexer and its tokens
+            Lexer(const char *begin, const char *end) :
+                Lexer(begin, end, 0, CommentState())
+            {
+                collecting = false;
+                numThreads = std::thread::hardware_concurrency();
+                parallelMinSize = 4 << 20;
             };
 
+            Lexer(const Lexer&) = delete;
+            Lexer& operator=(const Lexer&) = delete;
+
 
             // helper methods
-            void nextLine();        // this doesn't return but rather replaces the member tokenBuffer
+            void nextLine();        // this doesn't return but rather replaces the current line
             void skipWhiteSpace();
-            bool skipComments();
-            // Accessor methods
+            void skipTo(const char *end);
+            bool skipComments(bool atLineStart);
+            void skipBlockComment(char last, bool atLineStart, bool resuming);
+
+            void startToken(const char *start);
+            void appendToken(const char *from, const char *to);
+            std::string_view tokenText();
+
+            // print a non fatal message now, or keep it for tokenizeAll callers
+            void report(std::string message);
+
+            // Accessor methods, lexical errors come back as ERROR tokens
             Token getNextToken();
 
+            /**
+             * @brief Lex the rest of the file into the token store in one pass
+             *
+             *  Messages getNextToken would print are kept in diagnostics() in
+             *  order instead, lexical errors are ERROR tokens in the store.
+             *
+             * @return const TokenStore& every token of the file, END not included
+             */
+            const TokenStore & tokenizeAll();
+
+            /**
+             * @brief Configure parallel lexing in tokenizeAll
+             *
+             *  Sources smaller than minSize, or any source when numThreads is
+             *  below 2, are lexed on the calling thread.
+             */
+            void setParallelism(unsigned numThreads, std::size_t minSize = 4 << 20);
+
+            // keep messages in diagnostics() rather than printing them, tokenizeAll
+            // always does
+            void keepDiagnostics(bool keep) { collecting = keep; };
+
+            // forget messages kept for tokens from index numTokens on, as if
+            // lexing had stopped ahead of that token
+            void dropDiagnostics(std::uint32_t numTokens);
+
+            const TokenStore & tokenStore() const { return tokens; };
+            const Symbols & symbols() const { return symbolPool; };
+            const std::vector<Diagnostic> & diagnostics() const { return diagnosticList; };
+
+            /**
+             * @brief Advance cursor while predicate holds
+             *
+             *  Mirrors the stream based reader: every character taken advances the
+             *  column, and a NUL that stops the run is consumed rather than left
+             *  in the line.
+             *
+             * @return const char* end of the matched run
+             */
             template<typename UnaryPredicate>
-            void takeWhile(UnaryPredicate predicate)
+            const char * takeWhile(UnaryPredicate predicate)
             {
-                char in;
-                lineStream.get(in);
-
-                // #ifdef DEBUG
-                // std::cout << "Reading any all tokens that match predicate..." << std::endl;
-                // #endif 
+                const char *start = cursor;
 
-                while(!lineStream.eof() && predicate(in))
+                while (cursor < lineEnd && predicate(*cursor))
                 {
-                    tokenBuffer << in;
-                    // #ifdef DEBUG
-                    // std::cout << "Character matches: " << in << std::endl;
-                    // std::cout << "Took character incrementing column count " << std::endl;
-                    // #endif
-                    columnNumber++;
-                    lineStream.get(in);
+                    cursor++;
                 }
 
-                // whichever character was taken from string that broke loop needs to be put back
-                if (in != '\0') {
-                    lineStream.putback(in);
-                }
+                const char *end = cursor;
+                columnNumber += end - start;
+
+                if (cursor < lineEnd && *cursor == '\0')
+                    cursor++;
 
-                #ifdef DEBUG
-                std::cout << "Found token string: " << tokenBuffer.str() << std::endl;
-                #endif
+                return end;
             }
+
+            /**
+             * @brief Add characters to token buffer while predicate holds
+             *
+             */
             template<typename UnaryPredicate>
-            void takeWhile(UnaryPredicate predicate, int maxChars)
+            void takeTokenWhile(UnaryPredicate predicate)
             {
-                char in;
-                lineStream.get(in);
-
-                // get current length
-                int numChars = tokenBuffer.str().length();
-
-                while(numChars < maxChars && predicate(in))
-                {
-                    tokenBuffer << in;
-                }
+                const char *start = cursor;
+                const char *end = takeWhile(predicate);
 
-                // whichever character was taken from string that broke loop needs to be put back
-                lineStream.put(in);
+                appendToken(start, end);
             }
     };
-}
\ No newline at end of file
+}
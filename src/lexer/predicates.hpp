@@ -1,141 +1,117 @@
 #pragma once
 
-#include <locale>
+#include <array>
+#include <cstdint>
+
+namespace CharClass {
+    /*
+        Every class the lexer asks about is one bit, a character may be in
+        several (e.g. 'a' is both Alpha and Identifier)
+    */
+    enum : std::uint16_t {
+        Alpha               = 1 << 0,
+        Number              = 1 << 1,
+        Identifier          = 1 << 2,
+        Operator            = 1 << 3,
+        DoubleCharOperator  = 1 << 4,
+        Separator           = 1 << 5,
+        WhiteSpace          = 1 << 6,
+        StringBody          = 1 << 7,
+        CommentBody         = 1 << 8,
+    };
 
-class isAlpha
-{
-    public:
-    bool operator() (const char &c) const
+    constexpr bool contains(const char *characters, char c)
     {
-        std::locale locale;
-        
-        return std::isalpha(c, locale);
+        for (; *characters != '\0'; characters++)
+        {
+            if (*characters == c)
+                return true;
+        }
+
+        return false;
     }
-};
 
-class isIdentifier
-{
-    public:
-    bool operator() (const char &c) const
+    /*
+        Built once at compile time, indexed by unsigned char. Classes match the
+        "C" locale so bytes above 0x7f are never alphabetic or numeric.
+    */
+    constexpr std::array<std::uint16_t, 256> buildTable()
     {
-        std::locale locale;
-        
-        return std::isalnum(c, locale) || c == '_';
+        std::array<std::uint16_t, 256> table{};
+
+        for (int i = 0; i < 256; i++)
+        {
+            char c = static_cast<char>(i);
+            std::uint16_t classes = 0;
+
+            bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            bool number = (c >= '0' && c <= '9');
+
+            if (alpha)
+                classes |= Alpha;
+            if (number)
+                classes |= Number;
+            if (alpha || number || c == '_')
+                classes |= Identifier;
+            if (contains("+-*/%<>=!&|", c))
+                classes |= Operator;
+            if (contains("&|", c))
+                classes |= DoubleCharOperator;
+            if (contains(";.,{}()", c))
+                classes |= Separator;
+            if (contains(" \t\n", c))
+                classes |= WhiteSpace;
+            if (c != '\"' && c != '\n')
+                classes |= StringBody;
+            if (c != '/')
+                classes |= CommentBody;
+
+            table[i] = classes;
+        }
+
+        return table;
     }
-};
 
-class isNumber
-{
-    public:
-    bool operator() (const char &c) const
+    inline constexpr std::array<std::uint16_t, 256> table = buildTable();
+
+    constexpr bool is(char c, std::uint16_t classes)
     {
-        std::locale locale;
-        
-        return std::isdigit(c, locale);
+        return (table[static_cast<unsigned char>(c)] & classes) != 0;
     }
-};
+}
 
 /*
-    This check is only for possible single char operators
+    Predicate functors handed to Lexer::takeWhile, each is a single table
+    lookup on the class table above
 */
-class isOperator
+template<std::uint16_t Classes>
+class isCharClass
 {
     public:
-    bool operator() (const char &c) const
+    constexpr bool operator() (const char &c) const
     {
-        std::string operators("+-*/%<>=!&|");
-
-        return operators.find(c) != std::string::npos;
+        return CharClass::is(c, Classes);
     }
 };
 
+using isAlpha = isCharClass<CharClass::Alpha>;
+using isIdentifier = isCharClass<CharClass::Identifier>;
+using isNumber = isCharClass<CharClass::Number>;
+
+/*
+    This check is only for possible single char operators
+*/
+using isOperator = isCharClass<CharClass::Operator>;
+
 /*
     This check is only for double char operators, while some operators
     like >=, ==, etc are not included here because they have single char
     representations, thus their collection will be done in map
 */
-class isOnlyDoubleCharOperator
-{
-    public:
-    bool operator() (const char &c) const
-    {
-        std::string operators("&|");
-        return operators.find(c) != std::string::npos;
-    }
-};
-
-class isSeparator
-{
-    public:
-    bool operator() (const char &c) const
-    {
-        std::string operators(";.,{}()");
-
-        return operators.find(c) != std::string::npos;
-    }
-};
-
-class isMatchingCharacters
-{
-    std::string characters;
-
-    public:
-    isMatchingCharacters(std::string characters) :
-        characters(characters)
-    {
-
-    };
-
-    bool operator() (const char &c) const
-    {
-        return characters.find(c) != std::string::npos;
-    };
-};
-
-class isNotMatchingCharacters
-{
-    std::string characters;
-
-    public:
-    isNotMatchingCharacters(std::string characters) :
-        characters(characters)
-    {
-
-    };
-
-    bool operator() (const char &c) const
-    {
-        return characters.find(c) == std::string::npos;
-    };
-};
-
-class isNotStringConstantEnd : public isNotMatchingCharacters
-{
-    public:
-    isNotStringConstantEnd() :
-        isNotMatchingCharacters{"\"\n"}
-    {
-    };
-};
-
-class isNotCommentEnd : public isNotMatchingCharacters
-{
-    public:
-    isNotCommentEnd() :
-        isNotMatchingCharacters{"/"}
-    {
-    };
-};
-
-class isWhiteSpace : public isMatchingCharacters
-{
-    public:
-    isWhiteSpace() :
-        isMatchingCharacters{" \t\n"}
-    {
-    };
-};
-
-
+using isOnlyDoubleCharOperator = isCharClass<CharClass::DoubleCharOperator>;
 
+using isSeparator = isCharClass<CharClass::Separator>;
 
+using isNotStringConstantEnd = isCharClass<CharClass::StringBody>;
+using isNotCommentEnd = isCharClass<CharClass::CommentBody>;
+using isWhiteSpace = isCharClass<CharClass::WhiteSpace>;
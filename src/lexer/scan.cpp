@@ -0,0 +1,131 @@
+#include <cstring>
+
+#include "scan.hpp"
+
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#define DECAF_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+
+namespace {
+    inline bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n';
+    }
+
+#ifdef DECAF_SCAN_X86
+    const char * skipWhiteSpaceSSE2(const char *p, const char *end)
+    {
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i newLine = _mm_set1_epi8('\n');
+
+        while (end - p >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i blank = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                _mm_cmpeq_epi8(chunk, newLine));
+
+            unsigned other = ~static_cast<unsigned>(_mm_movemask_epi8(blank)) & 0xFFFFu;
+            if (other != 0)
+                return p + __builtin_ctz(other);
+
+            p += 16;
+        }
+
+        return Scanner::Scan::skipWhiteSpaceScalar(p, end);
+    }
+
+    __attribute__((target("avx2")))
+    const char * skipWhiteSpaceAVX2(const char *p, const char *end)
+    {
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i newLine = _mm256_set1_epi8('\n');
+
+        while (end - p >= 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            __m256i blank = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tab)),
+                _mm256_cmpeq_epi8(chunk, newLine));
+
+            unsigned other = ~static_cast<unsigned>(_mm256_movemask_epi8(blank));
+            if (other != 0)
+                return p + __builtin_ctz(other);
+
+            p += 32;
+        }
+
+        return skipWhiteSpaceSSE2(p, end);
+    }
+#endif
+
+    typedef const char * (*SkipKernel)(const char *, const char *);
+
+    struct Kernels {
+        SkipKernel  skip;
+        const char  *name;
+    };
+
+    Kernels select()
+    {
+#ifdef DECAF_SCAN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return { skipWhiteSpaceAVX2, "avx2" };
+
+        return { skipWhiteSpaceSSE2, "sse2" };
+#else
+        return { Scanner::Scan::skipWhiteSpaceScalar, "scalar" };
+#endif
+    }
+
+    const Kernels & kernels()
+    {
+        static const Kernels selected = select();
+        return selected;
+    }
+}
+
+const char * Scanner::Scan::skipWhiteSpaceScalar(const char *begin, const char *end)
+{
+    while (begin < end && isBlank(*begin))
+        begin++;
+
+    return begin;
+}
+
+const char * Scanner::Scan::findScalar(const char *begin, const char *end, char c)
+{
+    while (begin < end && *begin != c)
+        begin++;
+
+    return begin;
+}
+
+const char * Scanner::Scan::skipWhiteSpace(const char *begin, const char *end)
+{
+    // most runs are a single space or none at all, skip the kernel for those
+    if (begin == end || !isBlank(*begin))
+        return begin;
+    if (begin + 1 == end || !isBlank(begin[1]))
+        return begin + 1;
+
+    return kernels().skip(begin, end);
+}
+
+const char * Scanner::Scan::find(const char *begin, const char *end, char c)
+{
+    // libc memchr is already a vectorized (SSE2/AVX2/EVEX) search
+    const void *found = (begin < end) ? std::memchr(begin, c, end - begin) : nullptr;
+
+    return (found != nullptr) ? static_cast<const char*>(found) : end;
+}
+
+const char * Scanner::Scan::kernelName()
+{
+    return kernels().name;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace Scanner {
+    /*
+        Vectorized scanning kernels used by the lexer to jump over runs of
+        characters. Each returns end if nothing stops the scan.
+    */
+    namespace Scan {
+        // first character in [begin, end) that is not ' ', '\t' or '\n'
+        const char * skipWhiteSpace(const char *begin, const char *end);
+
+        // first occurrence of c in [begin, end)
+        const char * find(const char *begin, const char *end, char c);
+
+        // plain loop versions, always available and used to check the kernels
+        const char * skipWhiteSpaceScalar(const char *begin, const char *end);
+        const char * findScalar(const char *begin, const char *end, char c);
+
+        // name of the kernel set picked for this cpu ("avx2", "sse2" or "scalar")
+        const char * kernelName();
+    }
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "source.hpp"
+
+
+Scanner::SourceBuffer::SourceBuffer(std::string file_path)
+    : data("")
+    , length(0)
+    , mapped(false)
+    , owned()
+{
+    if (file_path == "-")
+    {
+        load(STDIN_FILENO);
+        return;
+    }
+
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+
+    // Throw if source is bad so we dont lock up reading
+    // non-existant file
+    if (fd < 0)
+        throw std::invalid_argument("Invalid source file");
+
+    try {
+        load(fd);
+    }
+    catch (...) {
+        ::close(fd);
+        throw;
+    }
+
+    ::close(fd);
+}
+
+Scanner::SourceBuffer::SourceBuffer(int fd)
+    : data("")
+    , length(0)
+    , mapped(false)
+    , owned()
+{
+    load(fd);
+}
+
+void Scanner::SourceBuffer::load(int fd)
+{
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || S_ISDIR(info.st_mode))
+        throw std::invalid_argument("Invalid source file");
+
+    if (S_ISREG(info.st_mode))
+    {
+        length = info.st_size;
+
+        // mmap refuses zero length mappings, empty file keeps static empty data
+        if (length > 0)
+        {
+            void *region = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (region != MAP_FAILED)
+            {
+                ::madvise(region, length, MADV_SEQUENTIAL);
+                data = static_cast<const char*>(region);
+                mapped = true;
+            }
+        }
+    }
+
+    // pipes and devices cannot be mapped, read them in full instead. Reads go
+    // straight into the buffer, which doubles whenever it fills up
+    if (!mapped && !(S_ISREG(info.st_mode) && length == 0))
+    {
+        std::size_t used = 0;
+        owned.resize(std::max<std::size_t>(length, 1 << 20));
+
+        for (;;)
+        {
+            if (used == owned.size())
+                owned.resize(owned.size() * 2);
+
+            ssize_t numRead = ::read(fd, &owned[used], owned.size() - used);
+
+            if (numRead < 0 && errno == EINTR)
+                continue;
+            if (numRead <= 0)
+                break;
+
+            used += numRead;
+        }
+
+        owned.resize(used);
+        data = owned.data();
+        length = owned.size();
+    }
+}
+
+Scanner::SourceBuffer::~SourceBuffer()
+{
+    if (mapped)
+        ::munmap(const_cast<char*>(data), length);
+}
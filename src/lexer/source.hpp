@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace Scanner {
+    /**
+     * @brief Read only view of a whole source file
+     *
+     *  Regular files are memory mapped so the lexer can scan them in place,
+     *  anything that cannot be mapped (pipes, character devices) is read into
+     *  an owned buffer instead. Token text handed out by the lexer points into
+     *  this buffer so it must outlive every token produced from it.
+     *
+     *  The path "-" reads standard input.
+     */
+    class SourceBuffer {
+
+            const char  *data;
+            std::size_t  length;
+
+            // set when data is an mmap region that must be unmapped
+            bool         mapped;
+
+            // fallback storage when source could not be mapped
+            std::string  owned;
+
+            // map or read everything from fd, which is left open
+            void load(int fd);
+
+        public:
+            SourceBuffer(std::string file_path);
+
+            // read an already open descriptor (pipe, socket, file) to its end
+            explicit SourceBuffer(int fd);
+
+            // borrow [begin, end) of text owned elsewhere, nothing is copied
+            SourceBuffer(const char *begin, const char *end)
+                : data(begin)
+                , length(end - begin)
+                , mapped(false)
+                , owned()
+            {};
+
+            ~SourceBuffer();
+
+            SourceBuffer(const SourceBuffer&) = delete;
+            SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+            const char * begin() const { return data; };
+            const char * end() const { return data + length; };
+            std::size_t size() const { return length; };
+
+            std::string_view view() const { return std::string_view(data, length); };
+    };
+}
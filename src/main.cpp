@@ -1,41 +1,38 @@
 #include <iostream>
+#include <fstream>
 #include <unistd.h>
 #include <algorithm>
 
-// lexer includes to run only lexer
-#include "lexer/lexer.hpp"
-#include "lexer/exceptions.hpp"
+#include "lexer/source.hpp"
 
-// parser includes to run parsing after lexing input
-#include "parser/TreeGeneration.hpp"
-#include "parser/exceptions.hpp"
-
-#include <AST/AbstractSyntaxTree.hpp>
-
-#include <SymbolTable/generate.hpp>
-#include <semantic-analyzer/STTypeVisitor.hpp>
-
-#include <code-gen/CodeGenVisitor.hpp>
+// runs the stages for a function on source held in memory
+#include "decaf/compile.hpp"
 
 #define VERSION 0.1.0
 
-std::vector<std::string> vecFunctions{
-    "--parser",
-    "--lexer",
-    "--semantic-check",
-    "--code-gen"
+std::vector<std::pair<std::string, Decaf::Mode>> vecFunctions{
+    {"--parser", Decaf::Mode::Parser},
+    {"--lexer", Decaf::Mode::Lexer},
+    {"--syntax-only", Decaf::Mode::SyntaxOnly},
+    {"--signatures", Decaf::Mode::Signatures},
+    {"--semantic-check", Decaf::Mode::SemanticCheck},
+    {"--code-gen", Decaf::Mode::CodeGen}
 };
 
 int usage(const char* progName)
 {
-    std::cerr << "Usage: " << progName << " <file_path>" << std::endl;
-    std::cerr << "  file_path    -   path to source file to convert" << std::endl;
+    std::cerr << "Usage: " << progName << " [--all-errors] [function] <file_path>" << std::endl;
+    std::cerr << "  --all-errors -   report every syntax error instead of stopping at the first" << std::endl;
+    std::cerr << "  file_path    -   path to source file to convert, - for stdin" << std::endl;
 
     return 1;
 }
 
 std::string getFileName(const std::string &file_path)
 {
+    // stdin has no name, code gen then writes to stdout
+    if (file_path == "-")
+        return file_path;
 
     std::size_t start = file_path.find_last_of("/");
     std::size_t end = file_path.find_last_of(".");
@@ -45,109 +42,55 @@ std::string getFileName(const std::string &file_path)
 
 int main(int argc, char** argv) {
 
-    if (argc < 2 || argc > 3)
+    Decaf::Options options;
+
+    // flags come before the function and file
+    int first = 1;
+
+    if (argc > 2 && std::string(argv[first]) == "--all-errors")
+    {
+        options.recover = true;
+        first++;
+    }
+
+    if (argc - first < 1 || argc - first > 2)
     {
-        usage(argv[0]);
+        return usage(argv[0]);
     }
 
-    std::string function("--code-gen");
-    std::string file_path(argv[1]);
+    std::string file_path(argv[first]);
 
-    if (argc > 2 )
+    if (argc - first > 1 )
     {
-        function = std::string(argv[1]);
-        file_path = std::string(argv[2]);
+        std::string function(argv[first]);
+        file_path = std::string(argv[first + 1]);
 
-        auto it = std::find(vecFunctions.begin(), vecFunctions.end(), function);
+        auto it = std::find_if(vecFunctions.begin(), vecFunctions.end(),
+                                [&](const auto &entry) { return entry.first == function; });
 
         if (it == vecFunctions.end())
         {
             std::cerr << "Invalid function: " << function << std::endl << std::endl;
             return usage(argv[0]);
         }
-    }
-    
-    std::string file_name( getFileName(file_path) );
-    Scanner::Lexer lexer(file_path);
 
-    if (function.compare("--lexer") == 0)
-    {
-        // convert file to tokens
-        Scanner::Token token;
-        do {
-            try {
-                // std::cout << "Getting Token..."<< std::endl;
-                token = lexer.getNextToken();
-
-                std::cout << token;
-            } 
-            catch( Scanner::GenericException &exc ) {
-                std::cout << exc.what() << std::endl;
-                token.type = Scanner::Token::Type::ERROR;
-            }
-        } while (token.type != Scanner::Token::Type::END);
-        
-        // std::cout << "Ended at lexer function" << std::endl;
-        return 0;
-    }
-    // we continue onto parser
-    // convert file to AST
-    AST::Program prog;
-
-    try {
-        prog = AST::Program( Parser::treeGeneration( &lexer, function.compare("--parser") == 0 ) );
-
-        // std::cout << "Generating symbol tree\n";
-        SymbolTable::generate(&prog);
-
-    }
-    catch ( Parser::ParseException &exc)
-    {
-        std::cout << exc.what() << std::endl;
-        return 1;
-    }
-    catch ( SymbolTable::Exception &exc)
-    {
-        std::cout << exc.what() << std::endl;
-        return 1;
+        options.mode = it->second;
     }
     
-    if (function.compare("--parser") == 0)
-    {
-        // std::cout << "Ended at parser function" << std::endl;
-        return 0;
-    }
-    bool bTypeCheck(true);
-    try {
-        bTypeCheck = SemanticAnalyzer::typeCheck(&prog);
-    }
-    // Some Semantic checking can be "recoverable or at least ignore later invocations of issues"
-    // 
-    catch ( std::exception &exc )
-    {
-        std::cout << exc.what() << std::endl;
-        return 1;
-    }
+    std::string file_name( getFileName(file_path) );
+    Scanner::SourceBuffer source(file_path);
 
-    // stop after semantic checking
-    if (function.compare("--semantic-check") == 0)
-    {
-        // std::cout << "Ended at semantic-check function" << std::endl;
-        return 0;
-    }
+    options.output = &std::cout;
+    Decaf::Result result = Decaf::compile(source.view(), options);
 
-    //linking stage
-    if (bTypeCheck && prog.pScope->idLookup("main") == nullptr)
+    // code gen writes next to where it was run, stdin goes to stdout
+    if (! result.assembly.empty())
     {
-        bTypeCheck = false;
-        std::cout   << "\n*** Error.\n"
-                    << "*** Linker: function 'main' not defined\n\n";
-        return 1;
+        if (file_name == "-")
+            std::cout << result.assembly;
+        else
+            std::ofstream(file_name + ".s") << result.assembly;
     }
 
-    // code gen
-    if (bTypeCheck)
-        CodeGen::generate(&prog, file_name);
-
-    return 0;
+    return result.stopped ? 1 : 0;
 }
@@ -0,0 +1,828 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <common/Arena.hpp>
+#include <lexer/lexer.hpp>
+#include <token/token.hpp>
+
+#include "ParserContext.hpp"
+#include "exceptions.hpp"
+
+/*
+    The recursive descent grammar, written once for any kind of tree.
+
+    Every parse function takes a Builder that makes the nodes, the grammar
+    only decides what is read and what is an error. The same tokens are read
+    ahead, consumed and reported for every builder, so a parse tree and an
+    AST of one source fail at the same token with the same message.
+
+    A Builder names its node pointer types and the calls that make them:
+
+        Expression, Statement, Call, Block, Function, Program
+
+        lvalue(ident)                   constant(token)
+        call(ident, lparen)             addActual(call, expr)
+        closeCall(call, rparen)         paren(lparen, expr, rparen)
+        unary(op, expr)                 binary(op, left, right)
+
+        expressionStmt(expr, semiColon)
+        whileStmt(keyword, lparen, expr, rparen, stmt)
+        ifStmt(keyword, lparen, expr, rparen, stmt, elseKeyword, elseStmt)
+        forStmt(keyword, lparen, startExpr, endStart, expr, endExpr, loopExpr, rparen, stmt)
+        breakStmt(keyword, semiColon)   returnStmt(keyword, expr, semiColon)
+
+        block(lbrace)                   addVariable(block, type, ident, semiColon)
+        addStatement(block, stmt)       closeBlock(block, rbrace)
+
+        function(type, ident, lparen)   addFormal(function, type, ident, comma)
+        closeFunction(function, rparen, block)
+
+        program()                       addVariable(program, type, ident, semiColon)
+        addFunction(program, function)
+
+    Block has to convert to Statement. Builders are instantiated with
+    parseProgram in the file that defines them.
+*/
+
+namespace Parser {
+
+    // Helpers shared by every instantiation, defined in TreeGeneration.cpp
+
+    // read ahead the same as the earlier expression parser did for every token
+    // it handled, so lexical errors further on surface at the same point
+    void topUpLookAhead(ParserContext &context);
+    void takeExprToken(ParserContext &context);
+
+    bool atSeparator(Scanner::Token token, std::string_view sep);
+    bool isBinaryOperator(Scanner::Token token);
+    bool isComparison(Scanner::Token::SubType subType);
+    int bindingPower(Scanner::Token op);
+
+    // error for the token in lookahead that cannot continue the expression
+    [[noreturn]] void unexpectedToken(ParserContext &context);
+
+    /**
+     * @brief Check for Type Ident and a separator at the front of the lookahead
+     *
+     * @return true the three tokens are in lookahead, false when the front
+     *      token is not a variable type
+     */
+    bool atVarDecl(ParserContext &context);
+
+    /*
+        Panic mode recovery. Called from a catch of exc, when the context
+        keeps errors they record exc and skip tokens up to a point the parse
+        can pick up from, otherwise they rethrow the exception being handled.
+        Skipped tokens are only consumed so the parse stays a single pass over
+        the input.
+    */
+
+    // thrown once recovery has skipped to the end of input, ends the parse
+    struct InputExhausted {};
+
+    // past the ; ending the statement, or up to the } closing its block
+    void skipStatement(ParserContext &context, ParseException &exc);
+
+    // up to the type starting the next top level declaration
+    void skipDeclaration(ParserContext &context, ParseException &exc);
+
+    // step over the function body at the front of the lookahead of a context
+    // over a store by matching its braces, returns its range in the store
+    std::pair<std::uint32_t, std::uint32_t> skipBody(ParserContext &context);
+
+    // a function body a skeleton parse stepped over, tokens [begin, end)
+    template <class Builder>
+    struct DeferredBody {
+        typename Builder::Function  function;
+        Scanner::Token              rparen;
+        std::uint32_t               begin;
+        std::uint32_t               end;
+    };
+
+
+    template <class Builder>
+    typename Builder::Statement parseStmt(ParserContext &context, Builder &builder);
+
+    /*
+        Expressions are parsed by precedence climbing straight into nodes.
+        The binding power of a binary operator is its SubType order, a higher
+        SubType binds tighter, and operators of equal power group to the
+        right. These are the trees the old postfix conversion produced, so
+        parser output is unchanged for every expression it accepted.
+    */
+
+    // expression parsed so far along with what the operand checks look at
+    template <class Builder>
+    struct Operand {
+        typename Builder::Expression    expr;
+        Scanner::Token                  op;     // root operator when expr is a binary expression, detached otherwise
+        bool                            lvalue;
+        Scanner::Token                  first;  // reported when expr cannot be assigned to
+    };
+
+    template <class Builder>
+    Operand<Builder> parseBinary(ParserContext &context, Builder &builder, int minPower, Scanner::Token before);
+
+    // Ident ( Actuals ), Ident is the front token
+    template <class Builder>
+    Operand<Builder> parseCall(ParserContext &context, Builder &builder)
+    {
+        Scanner::Token ident = context.peek(0);
+        context.consume(1);
+
+        Scanner::Token lparen = context.peek(0);
+        typename Builder::Call call = builder.call(ident, lparen);
+        takeExprToken(context);
+
+        Scanner::Token before = lparen;
+        std::size_t numActuals = 0;
+
+        // actuals separated by commas, if there are any
+        while (! atSeparator(context.peek(0), ")"))
+        {
+            builder.addActual(call, parseBinary(context, builder, 0, before).expr);
+            numActuals++;
+
+            if (atSeparator(context.peek(0), ","))
+            {
+                before = context.peek(0);
+                takeExprToken(context);
+
+                if (atSeparator(context.peek(0), ")"))
+                    throw Parser::ParseException(before);
+            }
+            else if (! atSeparator(context.peek(0), ")"))
+                unexpectedToken(context);
+        }
+
+        typename Builder::Expression expr = builder.closeCall(call, context.peek(0));
+        takeExprToken(context);
+
+        if (ident.symbol() == Scanner::Symbols::Print
+            && numActuals == 0 )
+        {
+            throw Parser::ParseException(lparen);
+        }
+        if ( (ident.symbol() == Scanner::Symbols::ReadInteger
+            || ident.symbol() == Scanner::Symbols::ReadLine )
+            && numActuals != 0 )
+        {
+            throw Parser::ParseException(lparen);
+        }
+
+        return { expr, Scanner::Token(), false, ident };
+    }
+
+    // operand with any prefix operators, before is the token that needs it
+    template <class Builder>
+    Operand<Builder> parseUnary(ParserContext &context, Builder &builder, Scanner::Token before)
+    {
+        Scanner::Token token = context.peek(0);
+
+        switch(token.type())
+        {
+            case Scanner::Token::Type::END:
+                throw Parser::ParseException(context.peek(0));
+
+            case Scanner::Token::Type::Identifier:
+                topUpLookAhead(context);
+
+                if (context.peek(1).subType() == Scanner::Token::SubType::Paren
+                    && context.peek(1).value() == "(")
+                    return parseCall(context, builder);
+                else
+                {
+                    context.consume(1);
+                    return { builder.lvalue(token), Scanner::Token(), true, token };
+                }
+
+            case Scanner::Token::Type::IntConstant :
+            case Scanner::Token::Type::DoubleConstant :
+            case Scanner::Token::Type::BoolConstant :
+            case Scanner::Token::Type::NullConstant :
+            case Scanner::Token::Type::StringConstant :
+                takeExprToken(context);
+                return { builder.constant(token), Scanner::Token(), false, token };
+
+            case Scanner::Token::Type::Operator:
+                if (token.subType() == Scanner::Token::SubType::Subtract
+                    || token.subType() == Scanner::Token::SubType::Not)
+                {
+                    takeExprToken(context);
+
+                    // prefix operators bind tighter than any binary operator
+                    Operand<Builder> operand = parseUnary(context, builder, token);
+
+                    return { builder.unary(token, operand.expr), Scanner::Token(), false, operand.first };
+                }
+                break;
+
+            case Scanner::Token::Type::Separator:
+                if (token.value() == "(")
+                {
+                    takeExprToken(context);
+
+                    typename Builder::Expression expr = parseBinary(context, builder, 0, token).expr;
+
+                    if (! atSeparator(context.peek(0), ")"))
+                        unexpectedToken(context);
+
+                    expr = builder.paren(token, expr, context.peek(0));
+                    takeExprToken(context);
+
+                    return { expr, Scanner::Token(), false, token };
+                }
+
+                // nothing between an operator and the end of its expression
+                if (token.value() == ")" || token.value() == "," || token.value() == ";")
+                    throw Parser::ParseException(before.type() != Scanner::Token::Type::END ? before : token);
+                break;
+
+            default:
+                break;
+        }
+
+        unexpectedToken(context);
+    }
+
+    template <class Builder>
+    Operand<Builder> binaryNode(Builder &builder, Scanner::Token op, Operand<Builder> left, Operand<Builder> right)
+    {
+        switch(op.subType())
+        {
+            case Scanner::Token::SubType::Assign:
+                if (! left.lvalue)
+                    throw Parser::ParseException(left.first);
+                break;
+            case Scanner::Token::SubType::Equal:
+            case Scanner::Token::SubType::NotEqual:
+            case Scanner::Token::SubType::LessThan:
+            case Scanner::Token::SubType::LessEqual:
+            case Scanner::Token::SubType::GreaterThan:
+            case Scanner::Token::SubType::GreaterEqual:
+                // comparisons don't chain, a > b > c is not parsable but a > b && a > c is
+                if (isComparison(right.op.subType()))
+                    throw Parser::ParseException(right.op);
+                if (isComparison(left.op.subType()))
+                    throw Parser::ParseException(op);
+                break;
+            default:
+                break;
+        }
+
+        return { builder.binary(op, left.expr, right.expr), op, false, left.first };
+    }
+
+    // operand followed by binary operators of at least minPower
+    template <class Builder>
+    Operand<Builder> parseBinary(ParserContext &context, Builder &builder, int minPower, Scanner::Token before)
+    {
+        Operand<Builder> left = parseUnary(context, builder, before);
+
+        while (isBinaryOperator(context.peek(0)) && bindingPower(context.peek(0)) >= minPower)
+        {
+            Scanner::Token op = context.peek(0);
+            takeExprToken(context);
+
+            Operand<Builder> right = parseBinary(context, builder, bindingPower(op), op);
+            left = binaryNode(builder, op, left, right);
+        }
+
+        return left;
+    }
+
+    /**
+     * @brief Parse an expression ending at sep, which is left in lookahead
+     *
+     * @return nullptr when sep comes straight away
+     */
+    template <class Builder>
+    typename Builder::Expression parseExpr(ParserContext &context, Builder &builder, std::string_view sep)
+    {
+        if (atSeparator(context.peek(0), sep))
+            return nullptr;
+
+        Operand<Builder> parsed = parseBinary(context, builder, 0, Scanner::Token());
+
+        if (! atSeparator(context.peek(0), sep))
+            unexpectedToken(context);
+
+        return parsed.expr;
+    }
+
+    template <class Builder>
+    typename Builder::Statement parseWhile(ParserContext &context, Builder &builder)
+    {
+        Scanner::Token keyword = context.peek(0);
+        context.consume(1);
+
+        if (! atSeparator(context.peek(0), "("))
+            throw Parser::ParseException(context.peek(0));
+
+        Scanner::Token lparen = context.peek(0);
+        context.consume(1);
+
+        // parse expr up until close paren
+        typename Builder::Expression expr = parseExpr(context, builder, ")");
+
+        if (expr == nullptr)
+            throw Parser::ParseException(context.peek(0));
+
+        Scanner::Token rparen = context.peek(0);
+        context.consume(1);
+
+        // parse statement(s)
+        typename Builder::Statement stmt = parseStmt(context, builder);
+
+        if (stmt == nullptr)
+            throw Parser::ParseException(context.peek(0));
+
+        return builder.whileStmt(keyword, lparen, expr, rparen, stmt);
+    }
+
+    template <class Builder>
+    typename Builder::Statement parseIfStmt(ParserContext &context, Builder &builder)
+    {
+        Scanner::Token keyword = context.peek(0);
+        context.consume(1);
+
+        if (! atSeparator(context.peek(0), "("))
+            throw Parser::ParseException(context.peek(0));
+
+        Scanner::Token lparen = context.peek(0);
+        context.consume(1);
+
+        // parse expr up until close paren
+        typename Builder::Expression expr = parseExpr(context, builder, ")");
+
+        if (expr == nullptr)
+            throw Parser::ParseException(context.peek(0));
+
+        Scanner::Token rparen = context.peek(0);
+        context.consume(1);
+
+        // parse statement(s)
+        typename Builder::Statement stmt = parseStmt(context, builder);
+
+        if (stmt == nullptr)
+            throw Parser::ParseException(context.peek(0));
+
+        Scanner::Token elseKeyword;
+        typename Builder::Statement elseStmt = nullptr;
+
+        if (context.peek(0).type() == Scanner::Token::Type::Else)
+        {
+            elseKeyword = context.peek(0);
+            context.consume(1);
+
+            elseStmt = parseStmt(context, builder);
+
+            if (elseStmt == nullptr)
+                throw Parser::ParseException(context.peek(0));
+        }
+
+        return builder.ifStmt(keyword, lparen, expr, rparen, stmt, elseKeyword, elseStmt);
+    }
+
+    template <class Builder>
+    typename Builder::Statement parseFor(ParserContext &context, Builder &builder)
+    {
+        Scanner::Token keyword = context.peek(0);
+        context.consume(1);
+
+        if (! atSeparator(context.peek(0), "("))
+            throw Parser::ParseException(context.peek(0));
+
+        Scanner::Token lparen = context.peek(0);
+        context.consume(1);
+
+        typename Builder::Expression startExpr = nullptr;
+
+        if (! atSeparator(context.peek(0), ";"))
+            startExpr = parseExpr(context, builder, ";");
+
+        Scanner::Token endStart = context.peek(0);
+        context.consume(1);
+
+        typename Builder::Expression expr = parseExpr(context, builder, ";");
+
+        if (expr == nullptr)
+            throw Parser::ParseException(context.peek(0));
+
+        Scanner::Token endExpr = context.peek(0);
+        context.consume(1);
+
+        typename Builder::Expression loopExpr = nullptr;
+
+        if (! atSeparator(context.peek(0), ")"))
+            loopExpr = parseExpr(context, builder, ")");
+
+        Scanner::Token rparen = context.peek(0);
+        context.consume(1);
+
+        typename Builder::Statement stmt = parseStmt(context, builder);
+
+        if (stmt == nullptr)
+            throw Parser::ParseException(context.peek(0));
+
+        return builder.forStmt(keyword, lparen, startExpr, endStart, expr, endExpr, loopExpr, rparen, stmt);
+    }
+
+    template <class Builder>
+    typename Builder::Block parseStmtBlock(ParserContext &context, Builder &builder)
+    {
+        Scanner::Token token = context.peek();
+
+        if (! atSeparator(token, "{"))
+            throw Parser::ParseException(token);
+
+        typename Builder::Block block = builder.block(token);
+
+        context.consume(1);
+
+        // While we haven't reached the end
+        if (! atSeparator(context.peek(0), "}"))
+        {
+            // parse var decls, will add to lookup as necessary
+            while (true)
+            {
+                try {
+                    if (! atVarDecl(context))
+                        break;
+
+                    // reported at the type, as the declaration is what is wrong
+                    if (! atSeparator(context.peek(2), ";"))
+                        throw Parser::ParseException(context.peek(0));
+                }
+                catch (Parser::ParseException &exc)
+                {
+                    skipStatement(context, exc);
+                    continue;
+                }
+
+                builder.addVariable(block, context.peek(0), context.peek(1), context.peek(2));
+                context.consume(3); // take varDecl tokens
+            }
+
+            // parse statements
+            while (! atSeparator(context.peek(0), "}"))
+            {
+                // extra tokens
+
+                typename Builder::Statement stmt = nullptr;
+
+                try {
+                    // recovery has to report input ending here, the parse
+                    // stops on it below otherwise
+                    if (context.recovering() && context.peek(0).type() == Scanner::Token::Type::END)
+                        throw Parser::ParseException(context.peek(0));
+
+                    // an empty statement adds nothing to the block
+                    if (atSeparator(context.peek(0), ";"))
+                    {
+                        context.consume(1);
+                        continue;
+                    }
+
+                    stmt = parseStmt(context, builder);
+
+                    if (stmt == nullptr)
+                        throw Parser::ParseException(context.peek(0));
+                }
+                catch (Parser::ParseException &exc)
+                {
+                    skipStatement(context, exc);
+                    continue;
+                }
+
+                builder.addStatement(block, stmt);
+            }
+        }
+
+        if (atSeparator(context.peek(0), "}"))
+        {
+            block = builder.closeBlock(block, context.peek(0));
+            context.consume(1);
+            return block;
+        }
+
+        return nullptr;
+    }
+
+    template <class Builder>
+    typename Builder::Statement parseStmt(ParserContext &context, Builder &builder)
+    {
+        Scanner::Token token = context.peek();
+
+        switch(token.type())
+        {
+            case Scanner::Token::Type::If:
+                return parseIfStmt(context, builder);
+            case Scanner::Token::Type::While:
+                return parseWhile(context, builder);
+            case Scanner::Token::Type::For:
+                return parseFor(context, builder);
+            case Scanner::Token::Type::Break:
+                {
+                    Scanner::Token keyword = context.peek(0);
+                    context.consume(1);
+
+                    if (! atSeparator(context.peek(0), ";"))
+                        throw Parser::ParseException(context.peek(0));
+
+                    typename Builder::Statement stmt = builder.breakStmt(keyword, context.peek(0));
+                    context.consume(1);
+
+                    return stmt;
+                }
+            case Scanner::Token::Type::Return:
+                {
+                    Scanner::Token keyword = context.peek(0);
+                    context.consume(1);
+
+                    // expr optional
+                    typename Builder::Expression expr = parseExpr(context, builder, ";");
+
+                    if (! atSeparator(context.peek(0), ";"))
+                        throw Parser::ParseException(context.peek(0));
+
+                    typename Builder::Statement stmt = builder.returnStmt(keyword, expr, context.peek(0));
+                    context.consume(1);
+
+                    return stmt;
+                }
+            case Scanner::Token::Type::Separator:
+                // any other separator, such as (, starts an expression
+                if (atSeparator(token, "{"))
+                    return parseStmtBlock(context, builder);
+                break;
+            case Scanner::Token::Type::Identifier:
+                if (Scanner::Token::lookupKeyword(token.value()).found)
+                    throw Parser::ParseException(token);
+                break;
+            default:
+                break;
+        }
+
+        typename Builder::Expression expr = parseExpr(context, builder, ";");
+
+        // a lone semicolon is not a statement
+        if (expr == nullptr)
+            throw Parser::ParseException(context.peek(0));
+
+        typename Builder::Statement stmt = builder.expressionStmt(expr, context.peek(0));
+        context.consume(1);
+
+        return stmt;
+    }
+
+    template <class Builder>
+    void parseFormals(ParserContext &context, Builder &builder, typename Builder::Function function)
+    {
+        // If we haven't hit the end of the formals keep going
+        while(! atSeparator(context.peek(), ")"))
+        {
+            // Here we need up to 3 tokens to determine which direction to go
+            context.addLookAhead(std::max(0, 3 - context.size()) );
+
+            if (! atVarDecl(context))
+                throw Parser::ParseException(context.peek(0));
+
+            if (atSeparator(context.peek(2), ","))
+            {
+                builder.addFormal(function, context.peek(0), context.peek(1), context.peek(2));
+                context.consume(3);
+            }
+            else
+            {
+                builder.addFormal(function, context.peek(0), context.peek(1), Scanner::Token(Scanner::Token::Type::EMPTY));
+                context.consume(2);
+            }
+        }
+        // leave rparen in token feed to be eaten by func decl
+    }
+
+    // adds the declaration at the front of the lookahead to program, false if it was skipped,
+    // function bodies are only stepped over and kept in deferred when it is given
+    template <class Builder>
+    bool parseDecl(ParserContext &context, Builder &builder, typename Builder::Program program,
+                   std::vector<DeferredBody<Builder>> *deferred)
+    {
+        // Decide what type of decl
+
+        // useful hold for error printing of current token in lookahead
+        Scanner::Token token = context.peek();
+
+        // Here we need up to 3 tokens to determine which direction to go
+        context.addLookAhead(std::max(0, 3 - context.size()) );
+
+        if (atSeparator(context.peek(2), ";"))
+        {
+            if (! atVarDecl(context))
+                throw Parser::ParseException(context.peek(0));
+
+            builder.addVariable(program, context.peek(0), context.peek(1), context.peek(2));
+            context.consume(3);  // take semi
+
+            return true;
+        }
+        else if (
+            context.peek(1).type() == Scanner::Token::Type::Identifier &&
+            atSeparator(context.peek(2), "(")
+        )
+        {
+            typename Builder::Function function = builder.function(token, context.peek(1), context.peek(2));
+
+            context.consume(3);
+
+            // should add tokens to lookup until see a rparen, for parsing validity
+            // before attempting to even verify formals are correct, but this is right 'recursive'
+
+            // Take tokens up to lparen, next lookahead should be start of formals
+            parseFormals(context, builder, function);
+            Scanner::Token rparen = context.peek();
+            // take rparen
+            context.consume(1);
+
+            if (deferred != nullptr)
+            {
+                std::pair<std::uint32_t, std::uint32_t> body = skipBody(context);
+
+                deferred->push_back({function, rparen, body.first, body.second});
+                builder.addFunction(program, function);
+
+                return true;
+            }
+
+            typename Builder::Block block = parseStmtBlock(context, builder);
+
+            if (block == nullptr)
+                throw Parser::ParseException(context.peek(0));
+
+            builder.closeFunction(function, rparen, block);
+            builder.addFunction(program, function);
+
+            return true;
+        }
+        else
+        {
+            // the caller reports the token after the type as the syntax error
+            context.consume(1);
+
+            return false;
+        }
+    }
+
+    template <class Builder>
+    typename Builder::Program parseProgram(ParserContext &context, Builder &builder,
+                                           std::vector<DeferredBody<Builder>> *deferred = nullptr)
+    {
+        typename Builder::Program program = builder.program();
+
+        while(context.peek().type() != Scanner::Token::Type::END )
+        {
+            Scanner::Token token = context.peek();
+
+            try {
+                switch(token.type())
+                {
+                    case Scanner::Token::Type::Int:
+                    case Scanner::Token::Type::Void:
+                    case Scanner::Token::Type::Bool:
+                    case Scanner::Token::Type::Double:
+                    case Scanner::Token::Type::String:
+                        if (! parseDecl(context, builder, program, deferred))
+                            throw Parser::ParseException(context.peek(0));
+                        break;
+                    default:
+                        throw Parser::ParseException(context.peek(0));
+                }
+            }
+            catch (Parser::ParseException &exc)
+            {
+                skipDeclaration(context, exc);
+            }
+            catch (InputExhausted &)
+            {
+                // the program is incomplete but every error in it is kept
+                break;
+            }
+        }
+
+        return program;
+    }
+
+    /*
+        Parse all of the file lexer reads with the bodies of its functions
+        spread over numThreads threads.
+
+        The whole file is lexed first. A skeleton parse then reads the top
+        level declarations in order, stepping over each function body by
+        matching its braces, and the bodies are parsed from their ranges of
+        the token store by workers taking them in turn. Each worker has a
+        builder of its own from makeBuilder(arena) and an arena the main one
+        adopts afterwards. The blocks are closed into their functions in
+        source order so the program is the one parseProgram makes.
+
+        Anything the skeleton or a body fails on parses the file again in
+        sequence instead, so the error thrown and the lexer messages kept
+        are those parseProgram reading from the lexer has. The parse only
+        reads the token store, so the same tokens can be parsed again.
+    */
+    template <class Builder, class MakeBuilder>
+    typename Builder::Program parseConcurrently(Scanner::Lexer *lexer, Builder &builder, Common::Arena &arena,
+                                                MakeBuilder makeBuilder, unsigned numThreads)
+    {
+        const Scanner::TokenStore &tokens = lexer->tokenizeAll();
+
+        typename Builder::Program program = nullptr;
+        std::vector<DeferredBody<Builder>> bodies;
+        std::vector<typename Builder::Block> blocks;
+        std::atomic<bool> failed(false);
+
+        try {
+            ParserContext context(tokens, 0, tokens.size());
+
+            context.addLookAhead();
+            program = parseProgram(context, builder, &bodies);
+        }
+        catch (...)
+        {
+            failed = true;
+        }
+
+        if (! failed)
+        {
+            blocks.resize(bodies.size());
+            numThreads = std::min<std::size_t>(numThreads, bodies.size());
+
+            std::vector<Common::Arena> arenas(numThreads);
+            std::vector<std::thread> workers;
+            std::atomic<std::size_t> next(0);
+
+            auto work = [&](Common::Arena &local) {
+                Builder bodyBuilder = makeBuilder(local);
+
+                for (std::size_t k; !failed && (k = next++) < bodies.size(); )
+                {
+                    try {
+                        ParserContext context(tokens, bodies[k].begin, bodies[k].end);
+
+                        context.addLookAhead();
+                        blocks[k] = parseStmtBlock(context, bodyBuilder);
+
+                        // the block has to take the whole range
+                        if (blocks[k] == nullptr || context.peek(0).type() != Scanner::Token::Type::END)
+                            failed = true;
+                    }
+                    catch (...)
+                    {
+                        failed = true;
+                    }
+                }
+            };
+
+            if (numThreads < 2)
+                work(arena);
+            else
+            {
+                for (unsigned t = 0; t < numThreads; t++)
+                    workers.emplace_back(work, std::ref(arenas[t]));
+
+                for (std::thread &worker : workers)
+                    worker.join();
+
+                for (Common::Arena &local : arenas)
+                    arena.adopt(local);
+            }
+        }
+
+        if (! failed)
+        {
+            for (std::size_t k = 0; k < bodies.size(); k++)
+                builder.closeFunction(bodies[k].function, bodies[k].rparen, blocks[k]);
+
+            return program;
+        }
+
+        // tokens past where the parse stops would not have been lexed yet
+        ParserContext context(tokens, 0, tokens.size());
+
+        try {
+            context.addLookAhead();
+            return parseProgram(context, builder);
+        }
+        catch (...)
+        {
+            lexer->dropDiagnostics(context.numRead());
+            throw;
+        }
+    }
+}
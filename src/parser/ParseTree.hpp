@@ -1,8 +1,11 @@
 #pragma once
 
+#include <string>
+#include <string_view>
 #include <vector>
 #include <deque>
 
+#include <common/Casting.hpp>
 #include <common/VisitorForward.hpp>
 
 #include "lexer/lexer.hpp"
@@ -12,23 +15,71 @@
 
 
 namespace Parser {
+    /*
+        Nodes are made in the Common::Arena of the parse and are never
+        deleted on their own, a tree is released with its arena.
+    */
+
     /** Non-Abstract / Derived Classes */
     /**
      * Pure Abstract defined classes
  */
     class ParseNode
     {
+        public:
+            /**
+             * @brief What the node is, for Common::isa / dyn_cast
+             *
+             *  Kinds of a class and the classes derived from it follow each
+             *  other, so classof checks a range. Abstract classes have none.
+             */
+            enum class Kind {
+                Identifier,
+                DeclarationType,
+                ReturnType,
+                AssignExpression,
+                ArithmeticExpression,
+                LogicalExpression,
+                RelationalExpression,
+                EqualityExpression,
+                UnaryExpression,
+                ParenExpr,
+                LValue,
+                Constant,
+                CallExpression,
+                PrintStmt,
+                ReadIntExpr,
+                ReadLineExpr,
+                StatementBlock,
+                ReturnStmt,
+                BreakStmt,
+                WhileStmt,
+                IfStmt,
+                ForStmt,
+                VariableDeclaration,
+                FormalVariableDeclaration,
+                FunctionDeclaration,
+                Program
+            };
+
         protected:
-            ParseNode()
+            ParseNode(Kind kind)
+                : nodeKind(kind)
             {};
             virtual std::string nodeName() = 0;
 
         public:
+            Kind kind() const { return nodeKind; };
+
             virtual int line() = 0;
-            virtual std::string toString(int numSpaces, std::string extra="") = 0;
+            // the tree from this node as --parser prints it, see ParseTreePrinter
+            std::string toString(int numSpaces = 0, std::string_view extra = "");
             virtual Scanner::Token firstToken() = 0;
 
             virtual void accept(Converter *visitor) = 0;
+
+        private:
+            Kind nodeKind;
     };
 
 
@@ -39,23 +90,25 @@ namespace Parser {
             Scanner::Token ident;
 
             Identifier()
-                : ParseNode()
+                : ParseNode(Kind::Identifier)
                 , ident()
             {
 
             };
 
             Identifier(const Identifier &i)
+                : ParseNode(Kind::Identifier)
             {
                 ident = i.ident;
             }
 
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::Identifier; };
+
             int line()
             {
-                return ident.lineNumber;
+                return ident.lineNumber();
             }
             std::string nodeName() { return "Identifier: "; };
-            std::string toString(int numSpaces, std::string extra="");
 
             Scanner::Token firstToken() { return ident; };
 
@@ -66,25 +119,36 @@ namespace Parser {
     {
         public:
             DeclarationType()
-                : ParseNode()
-                , type()
+                : DeclarationType(Kind::DeclarationType)
             {
 
             };
 
             DeclarationType(const DeclarationType & dt)
+                : ParseNode(Kind::DeclarationType)
             {
                 type = dt.type;
             }
 
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::DeclarationType && node->kind() <= Kind::ReturnType; };
+
+        protected:
+            DeclarationType(Kind kind)
+                : ParseNode(kind)
+                , type()
+            {
+
+            };
+
+        public:
+
             Scanner::Token type;
 
             int line()
             {
-                return type.lineNumber;
+                return type.lineNumber();
             }
             std::string nodeName() { return "Type: "; };
-            std::string toString(int numSpaces, std::string extra="");
             Scanner::Token firstToken() { return type; };
             void accept(Converter *converter);
     };
@@ -93,10 +157,12 @@ namespace Parser {
     {
         public:
             ReturnType()
-                : DeclarationType()
+                : DeclarationType(Kind::ReturnType)
             {
                 
             };
+
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::ReturnType; };
             std::string nodeName() { return "(return type) " + DeclarationType::nodeName(); };
             void accept(Converter *converter);
     };
@@ -104,7 +170,8 @@ namespace Parser {
     class Statement : public ParseNode
     {
         protected:
-            Statement()
+            Statement(Kind kind)
+                : ParseNode(kind)
             {
 
             };
@@ -116,7 +183,8 @@ namespace Parser {
             };
             virtual int line() { return 0; };
             virtual std::string nodeName() { return "Stmt: ";};
-            virtual std::string toString(int numSpaces, std::string extra="");
+
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::AssignExpression && node->kind() <= Kind::ForStmt; };
     };
 
 
@@ -124,47 +192,45 @@ namespace Parser {
     class Declarations : public ParseNode
     {
         protected:
-            Declarations()
-                : type(nullptr)
+            Declarations(Kind kind)
+                : ParseNode(kind)
+                , type(nullptr)
                 , ident()
             {
 
             };
 
         public:
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::VariableDeclaration && node->kind() <= Kind::FunctionDeclaration; };
+
             DeclarationType *type;
             Identifier      *ident;
-            virtual ~Declarations() {
-                delete type;
-                delete ident;
-            };
 
             int line()
             {
                 return ident->line();
             };
 
-            virtual std::string toString(int numSpaces, std::string extra="");
             virtual Scanner::Token firstToken() { return type->firstToken(); };
     };
 
     class Expression : public Statement
     {
-        public:
-            Expression()
-                : expr(nullptr)
+        protected:
+            Expression(Kind kind)
+                : Statement(kind)
+                , expr(nullptr)
             {
 
             };
-            virtual ~Expression()
-            {
-                delete expr;
-            };
+
+        public:
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::AssignExpression && node->kind() <= Kind::ReadLineExpr; };
+
             Expression *expr;
             Scanner::Token semiColon;
 
-            virtual int line() {return semiColon.lineNumber; };
-            virtual std::string toString(int numSpaces, std::string extra="");
+            virtual int line() {return semiColon.lineNumber(); };
             virtual Scanner::Token firstToken() { return (expr != nullptr) ? expr->firstToken() : semiColon; };
     };
 
@@ -174,25 +240,24 @@ namespace Parser {
             Scanner::Token op;
             Expression *right;
 
-            BinaryExpression()
-                : Expression()
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::AssignExpression && node->kind() <= Kind::EqualityExpression; };
+
+        protected:
+            BinaryExpression(Kind kind)
+                : Expression(kind)
                 , op()
                 , right(nullptr)
             {
 
             };
 
-            ~BinaryExpression()
-            {
-                delete right;
-            };
+        public:
 
             template<typename T>
             bool followExpr(T* follow) { return true; };
 
-            virtual int line() { return op.lineNumber; };
+            virtual int line() { return op.lineNumber(); };
             std::string nodeName() { return "BinExpr: "; };
-            virtual std::string toString(int numSpaces, std::string extra="");
             Scanner::Token firstToken() { return expr->firstToken(); };
     };
 
@@ -202,16 +267,17 @@ namespace Parser {
             Scanner::Token op;
 
             UnaryExpression()
-                : Expression()
+                : Expression(Kind::UnaryExpression)
                 , op()
             {
 
             };
 
-            int line() { return op.lineNumber; };
-            std::string nodeName() { return (op.subType == Scanner::Token::SubType::Not) ? "LogicalExpr:" : "ArithmeticExpr:"; };
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::UnaryExpression; };
+
+            int line() { return op.lineNumber(); };
+            std::string nodeName() { return (op.subType() == Scanner::Token::SubType::Not) ? "LogicalExpr:" : "ArithmeticExpr:"; };
             void accept(Converter *converter);
-            std::string toString(int numSpaces, std::string extra);
     };
 
 
@@ -223,6 +289,13 @@ namespace Parser {
     class AssignExpression : public BinaryExpression
     {
         public:
+            AssignExpression()
+                : BinaryExpression(Kind::AssignExpression)
+            {
+
+            };
+
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::AssignExpression; };
             std::string nodeName() { return "AssignExpr: "; };
             void accept(Converter *converter);
     };
@@ -230,6 +303,13 @@ namespace Parser {
     class ArithmeticExpression : public BinaryExpression
     {
         public:
+            ArithmeticExpression()
+                : BinaryExpression(Kind::ArithmeticExpression)
+            {
+
+            };
+
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::ArithmeticExpression; };
             std::string nodeName() { return "ArithmeticExpr:"; };
             void accept(Converter *converter);
     };
@@ -238,24 +318,45 @@ namespace Parser {
     class LogicalExpression : public BinaryExpression
     {
         public:
+            LogicalExpression()
+                : LogicalExpression(Kind::LogicalExpression)
+            {
+
+            };
+
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::LogicalExpression && node->kind() <= Kind::EqualityExpression; };
             std::string nodeName() { return "LogicalExpr:"; };
             void accept(Converter *converter);
 
             bool followExpr(LogicalExpression* follow) { 
-                if (op.subType == Scanner::Token::SubType::And ||
-                    op.subType == Scanner::Token::SubType::Or )
+                if (op.subType() == Scanner::Token::SubType::And ||
+                    op.subType() == Scanner::Token::SubType::Or )
                     return true;
-                else if ( follow->op.subType == Scanner::Token::SubType::And 
-                    || follow->op.subType == Scanner::Token::SubType::Or)
+                else if ( follow->op.subType() == Scanner::Token::SubType::And 
+                    || follow->op.subType() == Scanner::Token::SubType::Or)
                     return true;
                 else
                     return false;
                     };
+
+        protected:
+            LogicalExpression(Kind kind)
+                : BinaryExpression(kind)
+            {
+
+            };
     };
 
     class RelationalExpression: public LogicalExpression
     {
         public:
+            RelationalExpression()
+                : LogicalExpression(Kind::RelationalExpression)
+            {
+
+            };
+
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::RelationalExpression; };
             std::string nodeName() { return "RelationalExpr: ";};
             void accept(Converter *converter);
 
@@ -264,6 +365,13 @@ namespace Parser {
     class EqualityExpression: public LogicalExpression
     {
         public:
+            EqualityExpression()
+                : LogicalExpression(Kind::EqualityExpression)
+            {
+
+            };
+
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::EqualityExpression; };
             std::string nodeName() { return "EqualityExpr: "; };
             void accept(Converter *converter);
     };
@@ -278,14 +386,15 @@ namespace Parser {
             Scanner::Token rparen;
 
             ParenExpr()
-                : Expression()
+                : Expression(Kind::ParenExpr)
                 , lparen()
                 , rparen()
             {
 
             };
 
-            std::string toString(int numSpaces, std::string extra="");
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::ParenExpr; };
+
             Scanner::Token firstToken() { return lparen; };
             void accept(Converter *converter);
     };
@@ -299,20 +408,16 @@ namespace Parser {
             Identifier *ident;
 
             LValue()
-                : Expression()
+                : Expression(Kind::LValue)
                 , ident(nullptr)
             {
 
             };
 
-            ~LValue()
-            {
-                delete ident;
-            }
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::LValue; };
 
             int line() { return ident->line(); };
             std::string nodeName() { return "FieldAccess: "; };
-            std::string toString(int numSpaces, std::string extra="");
             Scanner::Token firstToken() { return ident->firstToken(); };
             void accept(Converter *converter);
     };
@@ -323,15 +428,16 @@ namespace Parser {
             Scanner::Token constant;
 
             Constant()
-                : Expression()
+                : Expression(Kind::Constant)
                 , constant()
             {
 
             };
 
-            int line() { return constant.lineNumber; };
-            std::string nodeName() { return Scanner::Token::getTypeName(constant.type) + ": "; }; 
-            std::string toString(int numSpaces, std::string extra="");
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::Constant; };
+
+            int line() { return constant.lineNumber(); };
+            std::string nodeName() { return Scanner::Token::getTypeName(constant.type()) + ": "; }; 
             Scanner::Token firstToken() { return constant; };
             void accept(Converter *converter);
     };
@@ -348,12 +454,23 @@ namespace Parser {
             Scanner::Token semiColon;
 
             VariableDeclaration() 
-                : Declarations()
+                : VariableDeclaration(Kind::VariableDeclaration)
+            {
+
+            };
+
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::VariableDeclaration && node->kind() <= Kind::FormalVariableDeclaration; };
+
+        protected:
+            VariableDeclaration(Kind kind)
+                : Declarations(kind)
                 , semiColon()
             {
 
             };
 
+        public:
+
             std::string nodeName() { return "VarDecl:"; };
             void accept(Converter *converter);
     };
@@ -368,7 +485,7 @@ namespace Parser {
             Scanner::Token rbrace;
             
             StatementBlock()
-                : Statement()
+                : Statement(Kind::StatementBlock)
                 , lbrace()
                 , vars()
                 , stmts()
@@ -376,21 +493,9 @@ namespace Parser {
 
             };
 
-            ~StatementBlock()
-            {
-                for (auto var : vars)
-                {
-                    delete var;
-                }
-
-                for (auto stmt : stmts)
-                {
-                    delete stmt;
-                }
-            }
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::StatementBlock; };
 
             std::string nodeName() { return "StmtBlock: "; };
-            std::string toString(int numSpaces, std::string extra="");
             Scanner::Token firstToken() { return lbrace; };
             void accept(Converter *converter);
     };
@@ -400,12 +505,12 @@ namespace Parser {
     {
         public:
             FormalVariableDeclaration() 
-                : VariableDeclaration()
+                : VariableDeclaration(Kind::FormalVariableDeclaration)
             {
 
             };
 
-            FormalVariableDeclaration(VariableDeclaration*var);
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::FormalVariableDeclaration; };
             std::string nodeName() { return "(formals) " + VariableDeclaration::nodeName(); };
             void accept(Converter *converter);
     };
@@ -420,7 +525,7 @@ namespace Parser {
             StatementBlock                              *block;
 
             FunctionDeclaration() 
-                : Declarations()
+                : Declarations(Kind::FunctionDeclaration)
                 , lparen()
                 , formals()
                 , rparen()
@@ -428,23 +533,23 @@ namespace Parser {
 
             };
 
-            ~FunctionDeclaration()
-            {
-                for( auto formal : formals)
-                {
-                    delete formal;
-                }
-            };
 
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::FunctionDeclaration; };
 
             std::string nodeName() { return "FnDecl:"; };
-            std::string toString(int numSpaces, std::string extra="");
             
             void accept(Converter *converter);
     };
 
     class Actual: public Expression
     {
+        protected:
+            Actual(Kind kind)
+                : Expression(kind)
+            {
+
+            };
+
         public:
 
             std::string nodeName() { return "(actual) " + expr->nodeName(); };
@@ -460,7 +565,16 @@ namespace Parser {
             Scanner::Token rparen;
 
             CallExpression() 
-                : Expression()
+                : CallExpression(Kind::CallExpression)
+            {
+
+            };
+
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::CallExpression && node->kind() <= Kind::ReadLineExpr; };
+
+        protected:
+            CallExpression(Kind kind)
+                : Expression(kind)
                 , ident(nullptr)
                 , actuals()
                 , lparen()
@@ -469,9 +583,10 @@ namespace Parser {
 
             };
 
-            int line() { return lparen.lineNumber; };
+        public:
+
+            int line() { return lparen.lineNumber(); };
             std::string nodeName() { return "Call: "; };
-            std::string toString(int numSpaces, std::string extra="");
             Scanner::Token firstToken() { return ident->firstToken(); };
             void accept(Converter *converter);
     };
@@ -481,14 +596,14 @@ namespace Parser {
         public:
 
             PrintStmt()
-                : CallExpression()
+                : CallExpression(Kind::PrintStmt)
             {
                 
             };
-            PrintStmt(CallExpression *expr);
+
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::PrintStmt; };
 
             std::string nodeName() { return "PrintStmt: "; };
-            std::string toString(int numSpaces, std::string extra="");
             void accept(Converter *converter);
     };
 
@@ -496,12 +611,13 @@ namespace Parser {
     {
         public:
         ReadIntExpr()
-                : CallExpression()
+                : CallExpression(Kind::ReadIntExpr)
             {
 
             };
 
-        std::string toString(int numSpaces, std::string extra="");
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::ReadIntExpr; };
+
         std::string nodeName() { return "ReadIntegerExpr: "; };
         void accept(Converter *converter);
     };
@@ -510,12 +626,13 @@ namespace Parser {
     {
         public:
             ReadLineExpr()
-                : CallExpression()
+                : CallExpression(Kind::ReadLineExpr)
             {
 
             };
+
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::ReadLineExpr; };
             
-        std::string toString(int numSpaces, std::string extra="");
         std::string nodeName() { return "ReadLineExpr: "; };
         void accept(Converter *converter);
     };
@@ -526,17 +643,21 @@ namespace Parser {
         public:
             Scanner::Token keyword;
             Expression* expr;
-            KeywordStmt()
-                : Statement()
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::ReturnStmt && node->kind() <= Kind::ForStmt; };
+
+        protected:
+            KeywordStmt(Kind kind)
+                : Statement(kind)
                 , keyword()
                 , expr(nullptr)
             {
 
             };
 
-            virtual int line() { return keyword.lineNumber; };
+        public:
+
+            virtual int line() { return keyword.lineNumber(); };
             virtual std::string nodeName() { return "KeywordStmt: "; };
-            virtual std::string toString(int numSpaces, std::string extra="");
             Scanner::Token firstToken() { return keyword; };
 
     };
@@ -546,28 +667,37 @@ namespace Parser {
     {
         public:
             ReturnStmt()
-                : KeywordStmt()
+                : ReturnStmt(Kind::ReturnStmt)
                 {
 
                 };
+
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::ReturnStmt && node->kind() <= Kind::BreakStmt; };
             
             Scanner::Token semiColon;
 
             std::string nodeName() { return "ReturnStmt: ";};
-            std::string toString(int numSpaces, std::string extra="");
             void accept(Converter *converter);
 
+        protected:
+            ReturnStmt(Kind kind)
+                : KeywordStmt(kind)
+                {
+
+                };
     };
 
     class BreakStmt : public ReturnStmt
     {
         public:
             BreakStmt()
-                : ReturnStmt()
+                : ReturnStmt(Kind::BreakStmt)
                 {
 
                 };
 
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::BreakStmt; };
+
             std::string nodeName() { return "BreakStmt: "; };
             void accept(Converter *converter);
     };
@@ -580,7 +710,16 @@ namespace Parser {
             Statement *stmt;
 
             WhileStmt()
-                : KeywordStmt()
+                : WhileStmt(Kind::WhileStmt)
+            {
+
+            };
+
+            static bool classof(const ParseNode *node) { return node->kind() >= Kind::WhileStmt && node->kind() <= Kind::ForStmt; };
+
+        protected:
+            WhileStmt(Kind kind)
+                : KeywordStmt(kind)
                 , lparen()
                 , rparen()
                 , stmt(nullptr)
@@ -588,8 +727,9 @@ namespace Parser {
 
             };
 
+        public:
+
             std::string nodeName() { return "WhileStmt: "; };
-            std::string toString(int numSpaces, std::string extra="");
             void accept(Converter *converter);
     };
 
@@ -600,15 +740,16 @@ namespace Parser {
             Statement *elseBlock;
 
             IfStmt()
-                : WhileStmt()
+                : WhileStmt(Kind::IfStmt)
                 , secondKeyword()
                 , elseBlock(nullptr)
             {
 
             };
 
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::IfStmt; };
+
             std::string nodeName() { return "IfStmt: "; };
-            std::string toString(int numSpaces, std::string extra="");
             void accept(Converter *converter);
     };
 
@@ -621,7 +762,7 @@ namespace Parser {
             Expression *loopExpr;
 
             ForStmt()
-                : WhileStmt()
+                : WhileStmt(Kind::ForStmt)
                 , startExpr(nullptr)
                 , endStart()
                 , endExpr()
@@ -630,8 +771,9 @@ namespace Parser {
 
             };
 
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::ForStmt; };
+
             std::string nodeName() { return "ForStmt: "; };
-            std::string toString(int numSpace, std::string extra="");
             void accept(Converter *converter);
     };
 
@@ -642,21 +784,15 @@ namespace Parser {
             std::vector<Declarations*> decls;
 
             Program()
-                : ParseNode()
+                : ParseNode(Kind::Program)
                 {
 
                 };
-            ~Program()
-            {
-                for (auto decl : decls)
-                {
-                    delete decl;
-                }
-            }
+
+            static bool classof(const ParseNode *node) { return node->kind() == Kind::Program; };
 
             std::string nodeName() { return "Program: "; };
             int line() { return 0; };
-            std::string toString(int numSpaces=0, std::string extra="");
 
             Scanner::Token firstToken() { return decls.at(0)->firstToken(); };
             void accept(Converter *converter);
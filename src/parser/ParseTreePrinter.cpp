@@ -0,0 +1,391 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#include "ParseTreePrinter.hpp"
+
+namespace Parser {
+
+    namespace {
+        constexpr std::string_view spaces = "                                                                ";
+    }
+
+    void ParseTreePrinter::print(ParseNode *node, int numSpaces, std::string_view extra)
+    {
+        place = {numSpaces, extra};
+        node->accept(this);
+    }
+
+    void ParseTreePrinter::line(int lineNumber)
+    {
+        char digits[16];
+        char *end = std::to_chars(digits, digits + sizeof(digits), lineNumber).ptr;
+
+        if (end - digits < 3)
+            writer.write(spaces.substr(0, 3 - (end - digits)));
+
+        writer.write(std::string_view(digits, end - digits));
+    }
+
+    void ParseTreePrinter::indent(int width)
+    {
+        for (width = std::max(width, 1); width > 0; width -= spaces.size())
+            writer.write(spaces.substr(0, std::min<std::size_t>(width, spaces.size())));
+    }
+
+    void ParseTreePrinter::text(const Scanner::Token &token)
+    {
+        std::string_view value = token.value();
+
+        // identifiers print as far as they are significant
+        if (token.type() == Scanner::Token::Type::Identifier)
+            value = value.substr(0, Scanner::Token::identifierMaxLength);
+
+        writer.write(value);
+    }
+
+    void ParseTreePrinter::number(double value, int precision)
+    {
+        // digits of the largest double before the point, the point and the decimals
+        scratch.resize(std::max<std::size_t>(scratch.size(), 320 + precision));
+
+        char *end = std::to_chars(scratch.data(), scratch.data() + scratch.size(), value,
+                                  std::chars_format::fixed, precision).ptr;
+
+        writer.write(std::string_view(scratch.data(), end - scratch.data()));
+    }
+
+    // the line every node starting with its line number opens with
+    void ParseTreePrinter::header(int lineNumber, Place at, std::string_view name)
+    {
+        line(lineNumber);
+        indent(at.numSpaces);
+        writer.write(at.extra);
+        writer.write(name);
+        writer.write('\n');
+    }
+
+    void ParseTreePrinter::declaration(Declarations *p, std::string_view name)
+    {
+        Place at = place;
+
+        header(p->ident->line(), at, name);
+        print(p->type, at.numSpaces + 3);
+        print(p->ident, at.numSpaces + 3);
+    }
+
+    void ParseTreePrinter::binary(BinaryExpression *p, std::string_view name)
+    {
+        Place at = place;
+
+        header(p->line(), at, name);
+
+        if (p->expr != nullptr)
+            print(p->expr, at.numSpaces + 3);
+
+        line(p->line());
+        indent(at.numSpaces + 3);
+        writer.write("Operator: ");
+        text(p->op);
+        writer.write('\n');
+
+        print(p->right, at.numSpaces + 3);
+    }
+
+    void ParseTreePrinter::keyword(ReturnStmt *p, std::string_view name)
+    {
+        Place at = place;
+
+        header(p->line(), at, name);
+
+        if (p->expr != nullptr)
+            print(p->expr, at.numSpaces + 3);
+        else if (p->keyword.type() == Scanner::Token::Type::Return)
+        {
+            indent(3);
+            indent(at.numSpaces + 3);
+            writer.write("Empty: \n");
+        }
+    }
+
+    void ParseTreePrinter::convert(Identifier *p)
+    {
+        line(p->ident.lineNumber());
+        indent(place.numSpaces);
+        writer.write(place.extra);
+        writer.write("Identifier: ");
+        text(p->ident);
+        writer.write('\n');
+    }
+
+    void ParseTreePrinter::convert(DeclarationType *p)
+    {
+        // we don't print number line for type
+        indent(place.numSpaces + 3);
+        writer.write(place.extra);
+        writer.write("Type: ");
+        text(p->type);
+        writer.write('\n');
+    }
+
+    void ParseTreePrinter::convert(ReturnType *p)
+    {
+        indent(place.numSpaces + 3);
+        writer.write(place.extra);
+        writer.write("(return type) Type: ");
+        text(p->type);
+        writer.write('\n');
+    }
+
+    void ParseTreePrinter::convert(UnaryExpression *p)
+    {
+        Place at = place;
+
+        header(p->line(), at, (p->op.subType() == Scanner::Token::SubType::Not) ? "LogicalExpr:" : "ArithmeticExpr:");
+
+        line(p->line());
+        indent(at.numSpaces + 3);
+        writer.write("Operator: ");
+        text(p->op);
+        writer.write('\n');
+
+        print(p->expr, at.numSpaces + 3);
+    }
+
+    void ParseTreePrinter::convert(AssignExpression *p)
+    {
+        binary(p, "AssignExpr: ");
+    }
+
+    void ParseTreePrinter::convert(ArithmeticExpression *p)
+    {
+        binary(p, "ArithmeticExpr:");
+    }
+
+    void ParseTreePrinter::convert(LogicalExpression *p)
+    {
+        binary(p, "LogicalExpr:");
+    }
+
+    void ParseTreePrinter::convert(RelationalExpression *p)
+    {
+        binary(p, "RelationalExpr: ");
+    }
+
+    void ParseTreePrinter::convert(EqualityExpression *p)
+    {
+        binary(p, "EqualityExpr: ");
+    }
+
+    void ParseTreePrinter::convert(ParenExpr *p)
+    {
+        // parens leave no node of their own
+        print(p->expr, place.numSpaces, place.extra);
+    }
+
+    void ParseTreePrinter::convert(LValue *p)
+    {
+        Place at = place;
+
+        header(p->ident->line(), at, "FieldAccess:");
+        print(p->ident, at.numSpaces + 3);
+    }
+
+    void ParseTreePrinter::convert(Constant *p)
+    {
+        Scanner::Token constant = p->constant;
+
+        line(constant.lineNumber());
+        indent(place.numSpaces);
+        writer.write(place.extra);
+        writer.write(Scanner::Token::enumName[static_cast<int>(constant.type())]);
+        writer.write(": ");
+
+        if (constant.type() == Scanner::Token::Type::DoubleConstant)
+        {
+            double integral = 0;
+            double value = std::modf(constant.getValue<double>(), &integral);
+
+            if (value == 0)
+            {
+                // general format with precision 6, as ostream prints by default
+                char digits[32];
+                char *end = std::to_chars(digits, digits + sizeof(digits), constant.getValue<double>(),
+                                          std::chars_format::general, 6).ptr;
+
+                writer.write(std::string_view(digits, end - digits));
+            }
+            else
+            {
+                // as many decimals as were written in the source
+                std::size_t decimal_index = constant.value().find('.');
+
+                int decimal_places = constant.value().length() - decimal_index - 1;
+
+                number(constant.getValue<double>(), (decimal_places < 1) ? 1 : decimal_places);
+            }
+        }
+        else if (constant.type() == Scanner::Token::Type::IntConstant)
+        {
+            char digits[16];
+            char *end = std::to_chars(digits, digits + sizeof(digits), constant.getValue<int>()).ptr;
+
+            writer.write(std::string_view(digits, end - digits));
+        }
+        else
+            text(constant);
+
+        writer.write('\n');
+    }
+
+    void ParseTreePrinter::convert(VariableDeclaration *p)
+    {
+        declaration(p, "VarDecl:");
+    }
+
+    void ParseTreePrinter::convert(FormalVariableDeclaration *p)
+    {
+        declaration(p, "(formals) VarDecl:");
+    }
+
+    void ParseTreePrinter::convert(FunctionDeclaration *p)
+    {
+        Place at = place;
+
+        declaration(p, "FnDecl:");
+
+        for (auto formal : p->formals)
+            print(formal, at.numSpaces + 3);
+
+        print(p->block, at.numSpaces + 3, "(body) ");
+    }
+
+    void ParseTreePrinter::convert(StatementBlock *p)
+    {
+        Place at = place;
+
+        indent(at.numSpaces + 3);
+        writer.write(at.extra);
+        writer.write("StmtBlock: \n");
+
+        for (auto var : p->vars)
+            print(var, at.numSpaces + 3);
+
+        for (auto stmt : p->stmts)
+            print(stmt, at.numSpaces + 3);
+    }
+
+    void ParseTreePrinter::convert(CallExpression *p)
+    {
+        Place at = place;
+
+        header(p->line(), at, "Call: ");
+
+        if (p->ident != nullptr)
+            print(p->ident, at.numSpaces + 3);
+
+        for (auto actual : p->actuals)
+            print(actual, at.numSpaces + 3, "(actuals) ");
+    }
+
+    void ParseTreePrinter::convert(PrintStmt *p)
+    {
+        Place at = place;
+
+        indent(at.numSpaces + 3);
+        writer.write(at.extra);
+        writer.write("PrintStmt: \n");
+
+        for (auto actual : p->actuals)
+            print(actual, at.numSpaces + 3, "(args) ");
+    }
+
+    void ParseTreePrinter::convert(ReadIntExpr *p)
+    {
+        header(p->line(), place, "ReadIntegerExpr: ");
+    }
+
+    void ParseTreePrinter::convert(ReadLineExpr *p)
+    {
+        header(p->line(), place, "ReadLineExpr: ");
+    }
+
+    void ParseTreePrinter::convert(ReturnStmt *p)
+    {
+        keyword(p, "ReturnStmt: ");
+    }
+
+    void ParseTreePrinter::convert(BreakStmt *p)
+    {
+        keyword(p, "BreakStmt: ");
+    }
+
+    void ParseTreePrinter::convert(WhileStmt *p)
+    {
+        Place at = place;
+
+        // a while is printed without the label its parent gives it
+        indent(at.numSpaces + 3);
+        writer.write("WhileStmt: \n");
+
+        print(p->expr, at.numSpaces + 3, "(test) ");
+        print(p->stmt, at.numSpaces + 3, "(body) ");
+    }
+
+    void ParseTreePrinter::convert(IfStmt *p)
+    {
+        Place at = place;
+
+        indent(at.numSpaces + 3);
+        writer.write(at.extra);
+        writer.write("IfStmt: \n");
+
+        print(p->expr, at.numSpaces + 3, "(test) ");
+        print(p->stmt, at.numSpaces + 3, "(then) ");
+
+        if (p->elseBlock != nullptr)
+            print(p->elseBlock, at.numSpaces + 3, "(else) ");
+    }
+
+    void ParseTreePrinter::convert(ForStmt *p)
+    {
+        Place at = place;
+
+        indent(at.numSpaces + 3);
+        writer.write(at.extra);
+        writer.write("ForStmt: \n");
+
+        if (p->startExpr != nullptr)
+            print(p->startExpr, at.numSpaces + 3, "(init) ");
+        else
+        {
+            indent(at.numSpaces + 6);
+            writer.write("(init) Empty:\n");
+        }
+
+        print(p->expr, at.numSpaces + 3, "(test) ");
+
+        if (p->loopExpr != nullptr)
+            print(p->loopExpr, at.numSpaces + 3, "(step) ");
+        else
+        {
+            // an empty step has the test's line and no label
+            line(p->expr->line());
+            indent(at.numSpaces);
+            writer.write("Empty: \n");
+        }
+
+        print(p->stmt, at.numSpaces + 3, "(body) ");
+    }
+
+    void ParseTreePrinter::convert(Program *p)
+    {
+        Place at = place;
+
+        indent(3);
+        writer.write("Program: \n");
+
+        for (auto decl : p->decls)
+            print(decl, at.numSpaces + 3);
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <visitor/parseVisitor.hpp>
+#include <token/writer.hpp>
+
+#include "ParseTree.hpp"
+
+namespace Parser {
+    /**
+     * @brief Writes a parse tree in the layout --parser prints
+     *
+     *  Each node is visited once and its lines go straight into a buffered
+     *  Scanner::TokenWriter. The indent and label of the node being visited
+     *  are handed down as plain values, so no text is built per node and a
+     *  tree prints in time linear in its size however deep it is.
+     *
+     *  Output is written to the stream when the buffer fills and when the
+     *  printer is flushed or destroyed.
+     */
+    class ParseTreePrinter : public Converter {
+
+        public:
+            ParseTreePrinter(std::ostream &out, std::size_t capacity = 1 << 16)
+                : writer(out, capacity)
+                , place{0, ""}
+                , scratch()
+            {};
+
+            // node and everything under it, numSpaces in and labelled with extra
+            void print(ParseNode *node, int numSpaces = 0, std::string_view extra = "");
+
+            void flush() { writer.flush(); };
+
+            // these are abstract / inherited types
+            void convert(ParseNode*) {};
+            void convert(BinaryExpression*) {};
+            void convert(Expression*) {};
+            void convert(Statement*) {};
+            void convert(Actual*) {};
+            void convert(KeywordStmt*) {};
+            void convert(Declarations*) {};
+
+            void convert(Identifier *p);
+            void convert(DeclarationType *p);
+            void convert(ReturnType *p);
+            void convert(UnaryExpression *p);
+            void convert(AssignExpression *p);
+            void convert(ArithmeticExpression *p);
+            void convert(LogicalExpression *p);
+            void convert(RelationalExpression *p);
+            void convert(EqualityExpression *p);
+            void convert(ParenExpr *p);
+            void convert(LValue *p);
+            void convert(Constant *p);
+            void convert(VariableDeclaration *p);
+            void convert(StatementBlock *p);
+            void convert(FormalVariableDeclaration *p);
+            void convert(FunctionDeclaration *p);
+            void convert(CallExpression *p);
+            void convert(PrintStmt *p);
+            void convert(ReadIntExpr *p);
+            void convert(ReadLineExpr *p);
+            void convert(ReturnStmt *p);
+            void convert(BreakStmt *p);
+            void convert(WhileStmt *p);
+            void convert(IfStmt *p);
+            void convert(ForStmt *p);
+            void convert(Program *p);
+
+        private:
+            // where the node being visited is printed, set by print()
+            struct Place {
+                int                 numSpaces;
+                std::string_view    extra;
+            };
+
+            Scanner::TokenWriter    writer;
+            Place                   place;
+            std::vector<char>       scratch;    // fixed point doubles too long for the stack
+
+            // line number right aligned in 3 columns
+            void line(int lineNumber);
+
+            // width columns of spaces, always at least one
+            void indent(int width);
+
+            void text(const Scanner::Token &token);
+            void number(double value, int precision);
+
+            void header(int lineNumber, Place at, std::string_view name);
+            void declaration(Declarations *p, std::string_view name);
+            void binary(BinaryExpression *p, std::string_view name);
+            void keyword(ReturnStmt *p, std::string_view name);
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+#include <lexer/lexer.hpp>
+#include <token/token.hpp>
+
+namespace Parser {
+    class ParseException;
+
+    /**
+     * @brief State of one parse, handed to every parse function
+     *
+     *  Holds the token source and the lookahead window so that separate
+     *  parses share nothing and can run on different threads at once.
+     *
+     *  The window is a ring of token handles, peeking and consuming are
+     *  index arithmetic. Parsing needs at most a handful of tokens ahead so
+     *  the ring rarely has to grow past its starting capacity.
+     *
+     *  Given somewhere to keep syntax errors the parse recovers from them
+     *  and carries on, see skipStatement and skipDeclaration in Grammar.hpp.
+     *
+     *  Tokens come from the lexer as they are needed, or from a range of a
+     *  store the lexer filled ahead of time so separate parts of one file
+     *  can be parsed at once, see parseConcurrently.
+     */
+    class ParserContext {
+
+        public:
+            ParserContext(Scanner::Lexer *lexer, std::vector<ParseException> *errors = nullptr)
+                : lexer(lexer)
+                , tokens(nullptr)
+                , errors(errors)
+                , position(0)
+                , last(0)
+                , ring(initialCapacity)
+                , head(0)
+                , count(0)
+            {};
+
+            // parse tokens [begin, end) of tokens, END follows them
+            ParserContext(const Scanner::TokenStore &tokens, std::uint32_t begin, std::uint32_t end)
+                : lexer(nullptr)
+                , tokens(&tokens)
+                , errors(nullptr)
+                , position(begin)
+                , last(end)
+                , ring(initialCapacity)
+                , head(0)
+                , count(0)
+            {};
+
+            // where tokens are read from, exactly one is set
+            Scanner::Lexer      *lexer;
+            const Scanner::TokenStore *tokens;
+
+            // syntax errors recovered from in the order they were found, null
+            // when the first one ends the parse
+            std::vector<ParseException> *errors;
+
+            bool recovering() const { return errors != nullptr; };
+
+            // store index of the next token to parse, for a context over a store
+            std::uint32_t index() const { return position - count; };
+
+            // store index of the first token not read yet
+            std::uint32_t numRead() const { return position; };
+
+            // empty the lookahead and carry on reading from store index
+            void seek(std::uint32_t index);
+
+            // token k places after the next one to parse, it must have been read
+            Scanner::Token peek(int k = 0) const
+            {
+                if (k < 0 || k >= count)
+                    throw std::out_of_range("Parser lookahead index out of range");
+
+                return ring[(head + k) & (ring.size() - 1)];
+            };
+
+            // number of tokens read ahead
+            int size() const { return count; };
+
+            // read numLookAheads more tokens onto the back of the window
+            void addLookAhead(int numLookAheads = 1);
+
+            // drop parsed tokens from the front, reads the next token once all are gone
+            void consume(int numTokens);
+
+        private:
+            // power of two so positions wrap with a mask
+            static constexpr std::size_t initialCapacity = 8;
+
+            std::uint32_t position;
+            std::uint32_t last;
+
+            std::vector<Scanner::Token> ring;
+            std::size_t head;
+            int         count;
+
+            void grow();
+    };
+}
@@ -1,6 +1,6 @@
-#include <deque>
-#include <stack>
+#include <algorithm>
 #include <iomanip>
+#include <string_view>
 #include <exception>
 
 // custom library includes
@@ -10,1030 +10,618 @@
 
 // this libraries includes
 #include "TreeGeneration.hpp"
+#include "ParserContext.hpp"
+#include "Grammar.hpp"
 #include "ParseTree.hpp"
 #include "exceptions.hpp"
 
 namespace Parser {
-// Forward Decls for Recursive calls
-StatementBlock* parseStmtBlock();
-Statement* parseStmt();
 
 
-Scanner::Lexer             *glexer;
-std::deque<Scanner::Token> *tokenLookAhead;
-int tokenLookAheadIndex = -1;
+void ParserContext::grow()
+{
+    std::vector<Scanner::Token> larger(ring.size() * 2);
+
+    for (int i = 0; i < count; i++)
+        larger[i] = ring[(head + i) & (ring.size() - 1)];
 
+    ring.swap(larger);
+    head = 0;
+}
 
-void addLookAhead(int numLookAheads = 1)
+void ParserContext::addLookAhead(int numLookAheads)
 {
     for (int i = 0; i < numLookAheads; i++)
     {
-        tokenLookAhead->push_back(glexer->getNextToken());
-        tokenLookAheadIndex++;
+        Scanner::Token token;
+
+        if (lexer != nullptr)
+            token = lexer->getNextToken();
+        else if (position < last)
+            token = (*tokens)[position++];
+
+        // a lexical error ends the parse, reported the same way it always was
+        if (token.type() == Scanner::Token::Type::ERROR)
+            throw Scanner::tokenError(token);
+
+        if (static_cast<std::size_t>(count) == ring.size())
+            grow();
+
+        ring[(head + count) & (ring.size() - 1)] = token;
+        count++;
     }
 }
 
-void takeTokens(int numTokens)
+void ParserContext::seek(std::uint32_t index)
 {
-    if (numTokens > tokenLookAheadIndex + 1 )
-        throw std::runtime_error("Cannot take more tokens than what's in container");
+    head = 0;
+    count = 0;
+    position = index;
+}
 
-    for (int i = 0; i < numTokens; i++)
-    {
-        tokenLookAhead->pop_front();
-        tokenLookAheadIndex--;
-    }
+void ParserContext::consume(int numTokens)
+{
+    if (numTokens > count)
+        throw Parser::ParseException(peek(0));
+
+    head = (head + numTokens) & (ring.size() - 1);
+    count -= numTokens;
 
     // If we have eaten all the lookahead, then replace
-    if (tokenLookAheadIndex == -1)
+    if (count == 0)
         addLookAhead();
 }
 
-void eraseToken(Scanner::Token item)
+
+
+
+void topUpLookAhead(ParserContext &context)
 {
+    // no further than four tokens, only recovery leaves more in the window
+    // and topping those up would read further ahead on every call
+    context.addLookAhead(std::max(0, std::min(std::abs(2 - context.size()), 4 - context.size())) );
+}
+
+void takeExprToken(ParserContext &context)
+{
+    topUpLookAhead(context);
+    context.consume(1);
+}
 
-    for(auto it = tokenLookAhead->begin(); it != tokenLookAhead->end();)
+bool atSeparator(Scanner::Token token, std::string_view sep)
+{
+    return token.type() == Scanner::Token::Type::Separator && token.value() == sep;
+}
+
+bool isBinaryOperator(Scanner::Token token)
+{
+    switch(token.type())
     {
-        if (*it == item)
-        {
-            it = tokenLookAhead->erase(it);
-            tokenLookAheadIndex--;
-        } 
-        else
-        {
-            ++it;
-        }
+        case Scanner::Token::Type::Operator:
+        case Scanner::Token::Type::Equal:
+        case Scanner::Token::Type::NotEqual:
+        case Scanner::Token::Type::GreaterEqual:
+        case Scanner::Token::Type::LessEqual:
+        case Scanner::Token::Type::And:
+        case Scanner::Token::Type::Or:
+            break;
+        default:
+            return false;
     }
 
-    // If we have eaten all the lookahead, then replace
-    if (tokenLookAheadIndex == -1)
-        addLookAhead();
+    Scanner::Token::SubType subType = token.subType();
+
+    return subType == Scanner::Token::SubType::Assign
+        || (subType >= Scanner::Token::SubType::And && subType <= Scanner::Token::SubType::Modulus);
 }
 
-void insertFront(Scanner::Token item)
+bool isComparison(Scanner::Token::SubType subType)
 {
-    tokenLookAhead->push_front(item);
+    return subType >= Scanner::Token::SubType::LessThan && subType <= Scanner::Token::SubType::NotEqual;
+}
 
-    // reset tokenLookAhead
-    tokenLookAheadIndex = 0;
+int bindingPower(Scanner::Token op)
+{
+    return static_cast<int>(op.subType());
 }
 
+[[noreturn]] void unexpectedToken(ParserContext &context)
+{
+    if (context.peek(0).type() == Scanner::Token::Type::END)
+        throw Parser::ParseException(context.peek(0));
+
+    topUpLookAhead(context);
+
+    Scanner::Token token = context.peek(0);
 
+    // stray separators are reported at the token following them
+    if (token.type() == Scanner::Token::Type::Separator
+        && token.subType() != Scanner::Token::SubType::Paren
+        && token.subType() != Scanner::Token::SubType::Comma)
+    {
+        context.addLookAhead(2);
+        if (context.size() < 2)
+            throw Parser::ParseException(context.peek(0));
+        else
+            throw Parser::ParseException(context.peek(1));
+    }
 
+    throw Parser::ParseException(token);
+}
 
-VariableDeclaration* parseVarDecl()
+bool atVarDecl(ParserContext &context)
 {
-    Scanner::Token token = tokenLookAhead->front();
+    Scanner::Token token = context.peek();
 
-    if (tokenLookAheadIndex + 1 < 3)
+    if (context.size() < 3)
     {
-        addLookAhead(std::abs(3 - (tokenLookAheadIndex+1) ) );
+        context.addLookAhead(std::abs(3 - context.size()) );
     }
 
     // Variable Decl (we already checked Type to get here)
-    switch(token.type)
+    switch(token.type())
     {
         case Scanner::Token::Type::Int:
         case Scanner::Token::Type::Bool:
         case Scanner::Token::Type::Double:
         case Scanner::Token::Type::String:
             // Must be: Type Ident ;
-            
             if (
-                tokenLookAhead->at(1).type == Scanner::Token::Type::Identifier &&
-                tokenLookAhead->at(2).type == Scanner::Token::Type::Separator
+                context.peek(1).type() == Scanner::Token::Type::Identifier &&
+                context.peek(2).type() == Scanner::Token::Type::Separator
             )
-            {
-                // Type Node
-                DeclarationType *type = new DeclarationType();
-                type->type = token;
-
-                // Ident Node
-                Identifier *ident = new Identifier();
-                ident->ident = tokenLookAhead->at(1);
-
-                // Variable node
-                VariableDeclaration *var = new VariableDeclaration();
-                var->type = type;
-                var->ident = ident;
-                var->semiColon = tokenLookAhead->at(2);
-
-                return var;
-            }
-            else if (tokenLookAhead->at(1).type != Scanner::Token::Type::Identifier)
-                throw Parser::ParseException(tokenLookAhead->at(1));
+                return true;
+            else if (context.peek(1).type() != Scanner::Token::Type::Identifier)
+                throw Parser::ParseException(context.peek(1));
             else
-                throw Parser::ParseException(tokenLookAhead->at(2));
-            break;
+                throw Parser::ParseException(context.peek(2));
         default:
-            return nullptr;
+            return false;
     }
-
-    return nullptr;
 }
 
-void printStack(const char*name, std::stack<Scanner::Token> stack)
+void skipStatement(ParserContext &context, ParseException &exc)
 {
-    std::cout << name << "Stack" << ": ";
-    
-    while (! stack.empty())
-    {
-        std::cout << stack.top().getValue<std::string>() << " ";
-        stack.pop();
-    }
-    std::cout << std::endl;
-}
+    if (! context.recovering())
+        throw;
 
-std::stack<Scanner::Token> infix2postfix(std::string sep)
-{
-    std::stack<Scanner::Token> tokenStack;
-    // 
-    std::stack<Scanner::Token> opHold;
-
-    // keep last token evaluated, for finding unary operators
-    Scanner::Token last;
-    // keep going if we are evaluating a function call to prevent early outs in keyword statement parsing
-    bool gotLparen = false;
-    while ( (tokenLookAhead->at(0).getValue<std::string>().compare(sep) != 0 || gotLparen )
-    && tokenLookAhead->at(0).type != Scanner::Token::Type::END )
-    {
-        // always make sure there are at least two tokens before parsing
-        addLookAhead(std::abs(2 - (tokenLookAheadIndex+1) ) );
-        
-        switch(tokenLookAhead->at(0).type)
-        {
-            case Scanner::Token::Type::Identifier:
-                if (tokenLookAhead->at(1).subType == Scanner::Token::SubType::Paren
-                    && tokenLookAhead->at(1).getValue<std::string>().compare("(") == 0)
-                {
-                    tokenLookAhead->at(0).subType = Scanner::Token::SubType::Call;
-                    // add call to op hold, need to parse rest of exprs which may have their own ops
-                    opHold.push(tokenLookAhead->at(0));
-                } else
-                {
-                    // add LValue
-                    tokenStack.push(tokenLookAhead->at(0));
-                }
-                break;
-            case Scanner::Token::Type::IntConstant :
-            case Scanner::Token::Type::DoubleConstant : 
-            case Scanner::Token::Type::BoolConstant :
-            case Scanner::Token::Type::NullConstant : 
-            case Scanner::Token::Type::StringConstant :
-                // add constant 
-                tokenStack.push(tokenLookAhead->at(0));
-                break;
-            case Scanner::Token::Type::Operator:
-                if (tokenLookAhead->at(0).subType == Scanner::Token::SubType::Subtract 
-                && (
-                    tokenStack.empty() ||
-                    last.subType != Scanner::Token::SubType::Operand 
-                ))
-                {
-                    tokenLookAhead->at(0).subType = Scanner::Token::SubType::UnaryNegative;
-                }
-            case Scanner::Token::Type::Equal :
-            case Scanner::Token::Type::NotEqual :
-            case Scanner::Token::Type::GreaterEqual :
-            case Scanner::Token::Type::LessEqual :
-            case Scanner::Token::Type::And :
-            case Scanner::Token::Type::Or :
-                while (!opHold.empty() && opHold.top().subType > tokenLookAhead->at(0).subType)
-                {
-                    tokenStack.push(opHold.top());
-                    opHold.pop();
-                }
-                opHold.push(tokenLookAhead->at(0));
-                break;
-            case Scanner::Token::Type::Separator :
-                if (tokenLookAhead->at(0).subType == Scanner::Token::SubType::Paren
-                && tokenLookAhead->at(0).getValue<std::string>().compare("(") == 0)
-                {
-                    // push opening paren onto token stack
-                    tokenStack.push(tokenLookAhead->at(0));
-                    gotLparen = true;
-                    // push into opHold to know how many operators are in a parenthesis section
-                    opHold.push(tokenLookAhead->at(0));
-                } else if (tokenLookAhead->at(0).subType == Scanner::Token::SubType::Paren
-                || tokenLookAhead->at(0).subType == Scanner::Token::SubType::Comma)
-                {
-                    // push all operators that might be holding between paren or commas to make sure
-                    //  expr in parenthesis and arguments for functions are evaluated correctly 
-                    // dont take call token as we don't know if we are dealing with comma or paren
-                    while(!opHold.empty() && (opHold.top().subType != Scanner::Token::SubType::Paren
-                        && opHold.top().subType != Scanner::Token::SubType::Call) )
-                    {
-                        tokenStack.push(opHold.top());
-                        opHold.pop();
-                    }
-
-                    if (!opHold.empty() )
-                    {
-                        // pop paren we don't need it anymore
-                        if (opHold.top().subType == Scanner::Token::SubType::Paren)
-                            opHold.pop();
-                        
-                        // if we finish call then we need to pull that off
-                        if (tokenLookAhead->at(0).subType == Scanner::Token::SubType::Paren)
-                        {
-                            gotLparen = false; // reset lparen state since call/paren expression finished
-                            tokenStack.push(tokenLookAhead->at(0));
-                            if (!opHold.empty() && opHold.top().subType == Scanner::Token::SubType::Call)
-                            {
-                                tokenStack.push(opHold.top());
-                                opHold.pop();
-                            }
-                        }
-                    }
-                } else {
-                    addLookAhead(2);
-                    if (tokenLookAhead->size() < 2)
-                        throw Parser::ParseException(tokenLookAhead->at(0));
-                    else
-                        throw Parser::ParseException(tokenLookAhead->at(1));
-                }
-                break;
-            default:
-                // unexpected token here 
-                throw Parser::ParseException(tokenLookAhead->at(0));
-                break;
-
-        }
+    context.errors->push_back(exc);
 
-        // last token parsed
-        last = tokenLookAhead->at(0);
-        // parsed token, need to take
-        takeTokens(1);
+    // braces and parens opened while skipping belong to the statement, the
+    // ; in a for header does not end it
+    int braces = 0;
+    int parens = 0;
 
-    }
-    
-    if (tokenLookAhead->at(0).getValue<std::string>().compare(sep) != 0)
-        throw std::runtime_error("Invalid expression");
-
-    while (!opHold.empty())
+    while (true)
     {
-        tokenStack.push(opHold.top());
-        opHold.pop();
-    }
+        Scanner::Token token = context.peek(0);
 
-    return tokenStack;
-}
+        if (token.type() == Scanner::Token::Type::END)
+            throw InputExhausted();
 
-Expression* parseExpr(std::stack<Scanner::Token> &tokenStack)
-{
-    if (tokenStack.empty())
-        return nullptr;
-
-
-    switch (tokenStack.top().subType)
-    {
-    case Scanner::Token::SubType::Operand :
-        if (tokenStack.top().type == Scanner::Token::Type::Identifier )
+        if (atSeparator(token, "}"))
         {
-            LValue *lvalue = new LValue();
-            lvalue->ident = new Identifier();
-            lvalue->ident->ident = tokenStack.top();
-
-            tokenStack.pop();
+            // closes the enclosing block, left for it to take
+            if (braces == 0)
+                return;
 
-            return lvalue;
-        } else {
-            Constant *constant = new Constant();
-            constant->constant = tokenStack.top();
+            context.consume(1);
 
-            tokenStack.pop();
+            if (--braces == 0)
+                return;
 
-            return constant;
+            continue;
         }
-        break;
-    case Scanner::Token::SubType::Paren:
-        if (tokenStack.top().getValue<std::string>().compare(")") == 0)
-        {
-            ParenExpr *paren = new ParenExpr();
-            paren->rparen = tokenStack.top();
-
-            tokenStack.pop();
-            paren->expr = parseExpr(tokenStack);
-
-            if (tokenStack.top().getValue<std::string>().compare("(") != 0)
-                throw Parser::ParseException(tokenStack.top());
-            
-            paren->lparen = tokenStack.top();
-            tokenStack.pop();
 
-            return paren;
-        } else
-        {
-            return nullptr;
-        }
-        break;
-    case Scanner::Token::SubType::Assign:
-        {
-            AssignExpression *assign = new AssignExpression();
+        if (atSeparator(token, "{"))
+            braces++;
+        else if (atSeparator(token, "("))
+            parens++;
+        else if (atSeparator(token, ")") && parens > 0)
+            parens--;
 
-            assign->op = tokenStack.top();
+        context.consume(1);
 
-            tokenStack.pop();
-            assign->right = parseExpr(tokenStack);
-
-            if (assign->right == nullptr)
-                throw Parser::ParseException(assign->op);
-            
-            assign->expr = parseExpr(tokenStack);
-
-            if (assign->expr == nullptr)
-                throw Parser::ParseException(assign->op);
-
-            if (dynamic_cast<LValue*>(assign->expr) == nullptr)
-                throw Parser::ParseException(assign->expr->firstToken());
-
-            return assign;
-        }
-    case Scanner::Token::SubType::Add :
-    case Scanner::Token::SubType::Subtract :
-    case Scanner::Token::SubType::Divide :
-    case Scanner::Token::SubType::Multiply :
-    case Scanner::Token::SubType::Modulus :
-        {
-            ArithmeticExpression *math = new ArithmeticExpression();
-            math->op = tokenStack.top();
-
-            tokenStack.pop();
+        if (braces == 0 && parens == 0 && atSeparator(token, ";"))
+            return;
+    }
+}
 
-            Scanner::Token t;
-            if (!tokenStack.empty())
-                t = tokenStack.top();
+void skipDeclaration(ParserContext &context, ParseException &exc)
+{
+    if (! context.recovering())
+        throw;
 
-            math->right = parseExpr(tokenStack);
-            
-            if (math->right == nullptr)
-                throw Parser::ParseException(math->op);
+    context.errors->push_back(exc);
 
-            Scanner::Token t1;
-            if (!tokenStack.empty())
-                t = tokenStack.top();
+    // types inside a body or formals do not start a declaration
+    int depth = 0;
 
-            math->expr = parseExpr(tokenStack);
+    // the front token is always taken so a declaration that failed on its
+    // type does not stop here again
+    for (bool first = true; context.peek(0).type() != Scanner::Token::Type::END; first = false)
+    {
+        Scanner::Token token = context.peek(0);
 
-            if (math->expr == nullptr)
-                throw Parser::ParseException(math->op);
-            
-            return math;
-        }
-        break;    
-    case Scanner::Token::SubType::LessThan :
-    case Scanner::Token::SubType::LessEqual :
-    case Scanner::Token::SubType::GreaterThan :
-    case Scanner::Token::SubType::GreaterEqual :
-    case Scanner::Token::SubType::Equal :
-    case Scanner::Token::SubType::NotEqual :
-    case Scanner::Token::SubType::And :
-    case Scanner::Token::SubType::Or :
+        if (! first && depth == 0)
         {
-            LogicalExpression *logic;
-
-            Scanner::Token op = tokenStack.top();
-            if (op.subType == Scanner::Token::SubType::And || op.subType == Scanner::Token::SubType::Or)
-                logic = new LogicalExpression();
-            else if (op.subType == Scanner::Token::SubType::Equal || op.subType == Scanner::Token::SubType::NotEqual)
-                logic = new EqualityExpression();
-            else
-                logic = new RelationalExpression();
-            
-            
-            logic->op = op;
-
-            tokenStack.pop();
-            logic->right = parseExpr(tokenStack);
-
-            // Probably easier way to check
-            // This checks if the right expressions is a logical expression cannot have something like
-            // a > b > c (not parsable)
-            // a > b && a > c (parsable)
-            if (logic->right == nullptr)
-                throw Parser::ParseException(logic->op);
-
-            if (logic->op.subType != Scanner::Token::SubType::And && logic->op.subType != Scanner::Token::SubType::Or &&
-                dynamic_cast<BinaryExpression*>(logic->right) != nullptr && (
-                    dynamic_cast<BinaryExpression*>(logic->right)->op.subType  == Scanner::Token::SubType::LessThan
-                ||  dynamic_cast<BinaryExpression*>(logic->right)->op.subType  == Scanner::Token::SubType::LessEqual
-                ||  dynamic_cast<BinaryExpression*>(logic->right)->op.subType  == Scanner::Token::SubType::GreaterThan
-                ||  dynamic_cast<BinaryExpression*>(logic->right)->op.subType  == Scanner::Token::SubType::GreaterEqual
-                ||  dynamic_cast<BinaryExpression*>(logic->right)->op.subType  == Scanner::Token::SubType::Equal
-                ||  dynamic_cast<BinaryExpression*>(logic->right)->op.subType  == Scanner::Token::SubType::NotEqual) )
+            switch(token.type())
             {
-                throw Parser::ParseException(dynamic_cast<BinaryExpression*>(logic->right)->op);
+                case Scanner::Token::Type::Int:
+                case Scanner::Token::Type::Void:
+                case Scanner::Token::Type::Bool:
+                case Scanner::Token::Type::Double:
+                case Scanner::Token::Type::String:
+                    return;
+                default:
+                    break;
             }
-
-            logic->expr = parseExpr(tokenStack);
-
-            if (logic->right == nullptr)
-                throw Parser::ParseException(logic->op);
-            
-            if (logic->op.subType != Scanner::Token::SubType::And && logic->op.subType != Scanner::Token::SubType::Or &&
-                dynamic_cast<BinaryExpression*>(logic->expr) != nullptr 
-                && (   dynamic_cast<BinaryExpression*>(logic->expr)->op.subType  == Scanner::Token::SubType::LessThan
-                    || dynamic_cast<BinaryExpression*>(logic->expr)->op.subType  == Scanner::Token::SubType::GreaterThan
-                    || dynamic_cast<BinaryExpression*>(logic->expr)->op.subType  == Scanner::Token::SubType::GreaterEqual
-                    || dynamic_cast<BinaryExpression*>(logic->expr)->op.subType  == Scanner::Token::SubType::Equal
-                    || dynamic_cast<BinaryExpression*>(logic->expr)->op.subType  == Scanner::Token::SubType::LessEqual
-                    || dynamic_cast<BinaryExpression*>(logic->expr)->op.subType  == Scanner::Token::SubType::NotEqual ) )
-            {
-                throw Parser::ParseException(dynamic_cast<BinaryExpression*>(logic->right)->op);
-            }
-
-            return logic;
         }
 
-    case Scanner::Token::SubType::Not :
-    case Scanner::Token::SubType::UnaryNegative :
-        {
-            UnaryExpression *unary = new UnaryExpression;
-            unary->op = tokenStack.top();
-
-            tokenStack.pop();
-            unary->expr = parseExpr(tokenStack);
-
-            if (unary->expr == nullptr)
-                throw Parser::ParseException(unary->op);
-
-            return unary;
-        }
-
-    case Scanner::Token::SubType::Call:
-        {
-            CallExpression *call;
-
-            if (tokenStack.top().getValue<std::string>().compare("Print") == 0)
-            {
-                call = new PrintStmt();
-            }
-            else if (tokenStack.top().getValue<std::string>().compare("ReadInteger") == 0)
-            {
-                call = new ReadIntExpr();
-            }
-            else if (tokenStack.top().getValue<std::string>().compare("ReadLine") == 0)
-            {
-                call = new ReadLineExpr();
-            }
-            else
-            {
-                call = new CallExpression();
-            }
+        if (atSeparator(token, "{") || atSeparator(token, "("))
+            depth++;
+        else if ((atSeparator(token, "}") || atSeparator(token, ")")) && depth > 0)
+            depth--;
 
-            call->ident = new Identifier();
-            call->ident->ident = tokenStack.top();
-            tokenStack.pop();
-
-            if (tokenStack.top().subType != Scanner::Token::SubType::Paren )
-                throw Parser::ParseException(tokenStack.top());
-            
-            call->rparen = tokenStack.top();
-            tokenStack.pop();
-
-            while(!tokenStack.empty() && tokenStack.top().subType != Scanner::Token::SubType::Paren )
-            {
-                call->actuals.push_front(parseExpr(tokenStack));
-            }
-
-            if (tokenStack.top().subType != Scanner::Token::SubType::Paren )
-                throw Parser::ParseException(tokenStack.top());
-            
-            call->lparen = tokenStack.top();
-            tokenStack.pop();
-
-
-            if (call->ident->ident.getValue<std::string>().compare("Print") == 0 
-                && call->actuals.size() == 0 )
-            {
-                throw Parser::ParseException(call->lparen);
-            }
-            if ( (call->ident->ident.getValue<std::string>().compare("ReadInteger") == 0 
-                || call->ident->ident.getValue<std::string>().compare("ReadLine") == 0 )
-                && call->actuals.size() != 0 )
-            {
-                throw Parser::ParseException(call->lparen);
-            }
-
-            // return empty expression
-            return call;
-        }
-        break;
-    default:
-        break;
+        context.consume(1);
     }
-
-
-    return nullptr;
-}
-
-WhileStmt * parseWhile()
-{
-    WhileStmt *stmt = new WhileStmt();
-
-    stmt->keyword = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    if (tokenLookAhead->at(0).getValue<std::string>().compare("(") != 0)
-        throw Parser::ParseException(tokenLookAhead->at(0));
-
-    stmt->lparen = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    // parse expr up until close paren
-    std::stack<Scanner::Token> tokens = infix2postfix(")");
-    stmt->expr = parseExpr(tokens);
-
-    if (stmt->expr == nullptr)
-        throw std::runtime_error("Invalid expression for while");
-
-    if (!tokens.empty())
-        throw Parser::ParseException(stmt->expr->firstToken());
-
-    if (tokenLookAhead->at(0).getValue<std::string>().compare(")") != 0)
-        throw Parser::ParseException(tokenLookAhead->at(0));
-
-    stmt->rparen = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    // parse statement(s)
-    stmt->stmt = parseStmt();
-
-    if (stmt->stmt == nullptr)
-        throw std::runtime_error("Expected statement for while");
-
-    return stmt;
 }
 
-IfStmt* parseIfStmt()
+std::pair<std::uint32_t, std::uint32_t> skipBody(ParserContext &context)
 {
-    IfStmt *stmt = new IfStmt();
-
-    stmt->keyword = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    if (tokenLookAhead->at(0).getValue<std::string>().compare("(") != 0)
-        throw Parser::ParseException(tokenLookAhead->at(0));
-
-    stmt->lparen = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    // parse expr up until close paren
-    std::stack<Scanner::Token> tokens = infix2postfix(")");
-    stmt->expr = parseExpr(tokens);
-
-    if (stmt->expr == nullptr)
-        throw std::runtime_error("Invalid expression for If");
-
-    if (!tokens.empty())
-        throw Parser::ParseException(stmt->expr->firstToken());
+    if (! atSeparator(context.peek(0), "{"))
+        throw Parser::ParseException(context.peek(0));
 
-    if (tokenLookAhead->at(0).getValue<std::string>().compare(")") != 0)
-        throw Parser::ParseException(tokenLookAhead->at(0));
+    const Scanner::TokenStore &tokens = *context.tokens;
+    std::uint32_t begin = context.index();
+    int depth = 0;
 
-    
-    stmt->rparen = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    // parse statement(s)
-    stmt->stmt = parseStmt();
-
-    if (stmt->stmt == nullptr)
-        throw std::runtime_error("Expected statement for If");
-
-
-    if (tokenLookAhead->at(0).type == Scanner::Token::Type::Else)
+    for (std::uint32_t i = begin; i < tokens.size(); i++)
     {
-        stmt->secondKeyword = tokenLookAhead->at(0);
-        takeTokens(1);
-
-        stmt->elseBlock = parseStmt();
-
-        if (stmt->elseBlock == nullptr)
-            throw std::runtime_error("Expected statement following else keyword");
-        
-    }
-    
-    return stmt;
-}
-
-ForStmt* parseFor()
-{
-    ForStmt *stmt = new ForStmt();
+        Scanner::Token token = tokens[i];
 
-    stmt->keyword = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    if (tokenLookAhead->at(0).getValue<std::string>().compare("(") != 0)
-        throw Parser::ParseException(tokenLookAhead->at(0));
+        // a lexical error ends the parse here too, read it to throw it
+        if (token.type() == Scanner::Token::Type::ERROR)
+        {
+            context.seek(i);
+            context.addLookAhead();
+        }
 
-    stmt->lparen = tokenLookAhead->at(0);
-    takeTokens(1);
+        if (atSeparator(token, "{"))
+            depth++;
+        else if (atSeparator(token, "}") && --depth == 0)
+        {
+            context.seek(i + 1);
+            context.addLookAhead();
 
-    if (tokenLookAhead->at(0).getValue<std::string>().compare(";") != 0)
-    {
-        std::stack<Scanner::Token> tokens = infix2postfix(";");
-        int numTokens = tokens.size();
-        stmt->startExpr = parseExpr(tokens);
-
-        if (stmt->startExpr == nullptr)
-            throw std::runtime_error("Expected expression");
-        
-        if (!tokens.empty())
-            throw Parser::ParseException(stmt->expr->firstToken());
-
-        // check again after parsing to verify
-        if (tokenLookAhead->at(0).getValue<std::string>().compare(";") != 0)
-            throw Parser::ParseException(tokenLookAhead->at(0));
-    } 
-    
-    stmt->endStart = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    std::stack<Scanner::Token> tokens = infix2postfix(";");
-    stmt->expr = parseExpr(tokens);
-
-    if (stmt->expr == nullptr)
-        throw std::runtime_error("Invalid Expression");
-
-    if (!tokens.empty())
-        throw Parser::ParseException(stmt->expr->firstToken());
-
-    if (tokenLookAhead->at(0).getValue<std::string>().compare(";") != 0)
-        throw Parser::ParseException(tokenLookAhead->at(0));
-    
-    stmt->endExpr = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    if (tokenLookAhead->at(0).getValue<std::string>().compare(")") != 0)
-    {
-        std::stack<Scanner::Token> tokens = infix2postfix(")");
-        stmt->loopExpr = parseExpr(tokens);
-
-        if (stmt->loopExpr == nullptr)
-            throw std::runtime_error("Expected expression");
-        
-        if (!tokens.empty())
-            throw Parser::ParseException(stmt->expr->firstToken()); 
-        
-        if (tokenLookAhead->at(0).getValue<std::string>().compare(")") != 0)
-            throw Parser::ParseException(tokenLookAhead->at(0));
+            return {begin, i + 1};
+        }
     }
 
-    stmt->rparen = tokenLookAhead->at(0);
-    takeTokens(1);
-
-    stmt->stmt = parseStmt();
-
-    if (stmt->stmt == nullptr)
-        throw std::runtime_error("Expected statement");
-
-    return stmt;
+    // unclosed, the parse in sequence reports it
+    throw Parser::ParseException(context.peek(0));
 }
 
-Statement* parseStmt()
-{
-    Scanner::Token token = tokenLookAhead->front();
-    
-    switch(token.type)
-    {
-        case Scanner::Token::Type::If:
-            return parseIfStmt();
-        case Scanner::Token::Type::While:
-            return parseWhile();
-            break;
-        case Scanner::Token::Type::For:
-            return parseFor();
-            break;
-        case Scanner::Token::Type::Break:
-            {
-                BreakStmt *breakStmt = new BreakStmt();
+// makes the parse tree nodes printed by --parser
+class ParseTreeBuilder {
+    public:
+        ParseTreeBuilder(Common::Arena &arena)
+            : arena(arena)
+        {};
+
+        using Expression = Parser::Expression*;
+        using Statement = Parser::Statement*;
+        using Call = CallExpression*;
+        using Block = StatementBlock*;
+        using Function = FunctionDeclaration*;
+        using Program = Parser::Program*;
+
+        Expression lvalue(Scanner::Token ident)
+        {
+            LValue *lvalue = arena.make<LValue>();
+            lvalue->ident = identifier(ident);
+            return lvalue;
+        }
 
-                breakStmt->keyword = tokenLookAhead->at(0);
-                takeTokens(1);
+        Expression constant(Scanner::Token token)
+        {
+            Constant *constant = arena.make<Constant>();
+            constant->constant = token;
+            return constant;
+        }
 
-                if (tokenLookAhead->at(0).getValue<std::string>().compare(";") != 0)
-                {
-                    throw std::runtime_error("Expected semicolon for break statement");
-                }
+        Call call(Scanner::Token ident, Scanner::Token lparen)
+        {
+            CallExpression *call;
 
-                breakStmt->semiColon = tokenLookAhead->at(0);
-                takeTokens(1);
+            if (ident.symbol() == Scanner::Symbols::Print)
+                call = arena.make<PrintStmt>();
+            else if (ident.symbol() == Scanner::Symbols::ReadInteger)
+                call = arena.make<ReadIntExpr>();
+            else if (ident.symbol() == Scanner::Symbols::ReadLine)
+                call = arena.make<ReadLineExpr>();
+            else
+                call = arena.make<CallExpression>();
 
-                return breakStmt;
-            }
-            break;
-        case Scanner::Token::Type::Return:
-            {
-                ReturnStmt *ret = new ReturnStmt();
-                ret->keyword = tokenLookAhead->at(0);
-                takeTokens(1);
-                std::stack<Scanner::Token> tokens = infix2postfix(";");
-                ret->expr = parseExpr(tokens);
+            call->ident = identifier(ident);
+            call->lparen = lparen;
+            return call;
+        }
 
-                if (!tokens.empty() && ret->expr != nullptr)
-                    throw Parser::ParseException(ret->expr->firstToken());
+        void addActual(Call call, Expression expr) { call->actuals.push_back(expr); }
 
-                if (!tokens.empty())
-                    throw Parser::ParseException(tokenLookAhead->at(0));
+        Expression closeCall(Call call, Scanner::Token rparen)
+        {
+            call->rparen = rparen;
+            return call;
+        }
 
-                if (tokenLookAhead->at(0).getValue<std::string>().compare(";") == 0)
-                {
-                    ret->semiColon = tokenLookAhead->at(0);
+        Expression paren(Scanner::Token lparen, Expression expr, Scanner::Token rparen)
+        {
+            ParenExpr *paren = arena.make<ParenExpr>();
+            paren->lparen = lparen;
+            paren->expr = expr;
+            paren->rparen = rparen;
+            return paren;
+        }
 
-                    // expr optional
-                    if (ret->expr != nullptr)
-                        ret->expr->semiColon = tokenLookAhead->at(0);
+        Expression unary(Scanner::Token op, Expression expr)
+        {
+            UnaryExpression *unary = arena.make<UnaryExpression>();
+            unary->op = op;
+            unary->expr = expr;
+            return unary;
+        }
 
-                    takeTokens(1);
-                }
-                else
-                    throw Parser::ParseException(tokenLookAhead->at(0));
+        Expression binary(Scanner::Token op, Expression left, Expression right)
+        {
+            BinaryExpression *binary;
 
-                return ret;
-            }
-            break;
-        case Scanner::Token::Type::Separator:
-            if (token.getValue<std::string>().compare("{") == 0)
-                return parseStmtBlock();
-            else    
-                return nullptr;
-        case Scanner::Token::Type::Identifier:
+            switch(op.subType())
             {
-                auto op = Scanner::Token::keywords.find(token.getValue<std::string>());
-                if (op != Scanner::Token::keywords.end())
-                    throw Parser::ParseException(token);
+                case Scanner::Token::SubType::Assign:
+                    binary = arena.make<AssignExpression>();
+                    break;
+                case Scanner::Token::SubType::And:
+                case Scanner::Token::SubType::Or:
+                    binary = arena.make<LogicalExpression>();
+                    break;
+                case Scanner::Token::SubType::Equal:
+                case Scanner::Token::SubType::NotEqual:
+                    binary = arena.make<EqualityExpression>();
+                    break;
+                case Scanner::Token::SubType::LessThan:
+                case Scanner::Token::SubType::LessEqual:
+                case Scanner::Token::SubType::GreaterThan:
+                case Scanner::Token::SubType::GreaterEqual:
+                    binary = arena.make<RelationalExpression>();
+                    break;
+                default:
+                    binary = arena.make<ArithmeticExpression>();
+                    break;
             }
-        default:
-            {
-                std::stack<Scanner::Token> tokens = infix2postfix(";");
-                Expression *expr = parseExpr(tokens);
-
-
-                // todo: add this logic to all expression parsing
-                if (!tokens.empty())
-                    throw Parser::ParseException(expr->firstToken());
 
-                if (tokenLookAhead->at(0).getValue<std::string>().compare(";") == 0)
-                {
-                    expr->semiColon = tokenLookAhead->at(0);
-                    takeTokens(1);
-                }
-                else
-                    throw std::runtime_error("Expected semicolon at end of expression");
-
-                return expr;
-            }
-            break;
-    }
+            binary->op = op;
+            binary->expr = left;
+            binary->right = right;
+            return binary;
+        }
 
-    return nullptr;
-}
+        Statement expressionStmt(Expression expr, Scanner::Token semiColon)
+        {
+            expr->semiColon = semiColon;
+            return expr;
+        }
 
-StatementBlock* parseStmtBlock()
-{
+        Statement whileStmt(Scanner::Token keyword, Scanner::Token lparen, Expression expr,
+                            Scanner::Token rparen, Statement stmt)
+        {
+            WhileStmt *whileStmt = arena.make<WhileStmt>();
+            setLoop(whileStmt, keyword, lparen, expr, rparen, stmt);
+            return whileStmt;
+        }
 
-    Scanner::Token token = tokenLookAhead->front();
+        Statement ifStmt(Scanner::Token keyword, Scanner::Token lparen, Expression expr,
+                         Scanner::Token rparen, Statement stmt, Scanner::Token elseKeyword, Statement elseStmt)
+        {
+            IfStmt *ifStmt = arena.make<IfStmt>();
+            setLoop(ifStmt, keyword, lparen, expr, rparen, stmt);
+            ifStmt->secondKeyword = elseKeyword;
+            ifStmt->elseBlock = elseStmt;
+            return ifStmt;
+        }
 
-    if (token.type != Scanner::Token::Type::Separator &&
-        token.getValue<std::string>().compare("{") != 0)
-    {
-        throw std::runtime_error("Expected opening brace to statement body");
-    }
+        Statement forStmt(Scanner::Token keyword, Scanner::Token lparen, Expression startExpr,
+                          Scanner::Token endStart, Expression expr, Scanner::Token endExpr,
+                          Expression loopExpr, Scanner::Token rparen, Statement stmt)
+        {
+            ForStmt *forStmt = arena.make<ForStmt>();
+            setLoop(forStmt, keyword, lparen, expr, rparen, stmt);
+            forStmt->startExpr = startExpr;
+            forStmt->endStart = endStart;
+            forStmt->endExpr = endExpr;
+            forStmt->loopExpr = loopExpr;
+            return forStmt;
+        }
 
-    StatementBlock * stmtBlock = new StatementBlock();
-    stmtBlock->lbrace = token;
+        Statement breakStmt(Scanner::Token keyword, Scanner::Token semiColon)
+        {
+            BreakStmt *breakStmt = arena.make<BreakStmt>();
+            breakStmt->keyword = keyword;
+            breakStmt->semiColon = semiColon;
+            return breakStmt;
+        }
 
-    takeTokens(1);
+        Statement returnStmt(Scanner::Token keyword, Expression expr, Scanner::Token semiColon)
+        {
+            ReturnStmt *ret = arena.make<ReturnStmt>();
+            ret->keyword = keyword;
+            ret->expr = expr;
+            ret->semiColon = semiColon;
 
-    // While we haven't reached the end
-    if (tokenLookAhead->at(0).getValue<std::string>().compare("}") != 0 )
-    {
-        // parse var decls
-        VariableDeclaration *varDecl = nullptr;
-        do {
-            // will add to lookup as necessary
-            varDecl = parseVarDecl();
+            if (expr != nullptr)
+                expr->semiColon = semiColon;
 
-            if (varDecl != nullptr)
-            {
-                if (varDecl->semiColon.getValue<std::string>().compare(";") != 0)
-                {
-                    throw std::runtime_error("Error expected semicolon to end statemnt");
-                }
-                takeTokens(3); // take varDecl tokens
-                stmtBlock->vars.push_back(varDecl);
-            }
-        } while(varDecl != nullptr);
+            return ret;
+        }
 
-        // parse statements
-        while (tokenLookAhead->at(0).getValue<std::string>().compare("}") != 0)
+        Block block(Scanner::Token lbrace)
         {
-            // extra tokens
+            StatementBlock *block = arena.make<StatementBlock>();
+            block->lbrace = lbrace;
+            return block;
+        }
 
-            Statement *stmt = parseStmt();
+        void addVariable(Block block, Scanner::Token type, Scanner::Token ident, Scanner::Token semiColon)
+        {
+            block->vars.push_back(variable(arena.make<VariableDeclaration>(), type, ident, semiColon));
+        }
 
-            if (stmt == nullptr && tokenLookAhead->at(0).getValue<std::string>().compare("}") != 0)
-            {
-                // normally throw, for debug just skip token
-                // throw std::runtime_error("Invalid token in statement");
-                std::cout << "StmtBlock: ";
-                std::cout << "Skipping Token: " << tokenLookAhead->at(0);
-                takeTokens(1);
-            }
+        void addStatement(Block block, Statement stmt) { block->stmts.push_back(stmt); }
 
-            if (stmt != nullptr )
-            {
-                stmtBlock->stmts.push_back(stmt);
-            }
-        }   
+        Block closeBlock(Block block, Scanner::Token rbrace)
+        {
+            block->rbrace = rbrace;
+            return block;
+        }
 
-    }
+        Function function(Scanner::Token type, Scanner::Token ident, Scanner::Token lparen)
+        {
+            FunctionDeclaration *func = arena.make<FunctionDeclaration>();
+            func->type = arena.make<ReturnType>();
+            func->type->type = type;
+            func->ident = identifier(ident);
+            func->lparen = lparen;
+            return func;
+        }
 
-    if (tokenLookAhead->at(0).getValue<std::string>().compare("}") == 0)
-    {
-        stmtBlock->rbrace = tokenLookAhead->at(0);
-        takeTokens(1);
-        return stmtBlock;
-    }
+        void addFormal(Function func, Scanner::Token type, Scanner::Token ident, Scanner::Token comma)
+        {
+            func->formals.push_back(variable(arena.make<FormalVariableDeclaration>(), type, ident, comma));
+        }
 
+        void closeFunction(Function func, Scanner::Token rparen, Block block)
+        {
+            func->rparen = rparen;
+            func->block = block;
+        }
 
-    return nullptr;
-}
+        Program program() { return arena.make<Parser::Program>(); }
 
-std::vector<FormalVariableDeclaration*> parseFormals()
-{
-    std::vector<FormalVariableDeclaration*> formals;
+        void addVariable(Program program, Scanner::Token type, Scanner::Token ident, Scanner::Token semiColon)
+        {
+            program->decls.push_back(variable(arena.make<VariableDeclaration>(), type, ident, semiColon));
+        }
 
-    // If we haven't hit the end of the formals keep going
-    while(tokenLookAhead->front().getValue<std::string>().compare(")") != 0)
-    {
-        // Here we need up to 3 tokens to determine which direction to go
-        addLookAhead(std::abs(3 - (tokenLookAheadIndex+1) ) );
-        VariableDeclaration *var = parseVarDecl();        
+        void addFunction(Program program, Function func) { program->decls.push_back(func); }
 
-        if (var == nullptr)
-            throw Parser::ParseException(tokenLookAhead->at(0));    
-        FormalVariableDeclaration *formalVar = new FormalVariableDeclaration(var);
+    private:
+        Common::Arena &arena;
 
-        if (var->semiColon.getValue<std::string>().compare(",") == 0)
+        Identifier* identifier(Scanner::Token token)
         {
-            formalVar->semiColon = var->semiColon; 
-            takeTokens(3);
+            Identifier *ident = arena.make<Identifier>();
+            ident->ident = token;
+            return ident;
         }
-        else
+
+        template <class Declaration>
+        Declaration* variable(Declaration *var, Scanner::Token type, Scanner::Token ident, Scanner::Token semiColon)
         {
-            formalVar->semiColon.type = Scanner::Token::Type::EMPTY;
-            takeTokens(2);
+            var->type = arena.make<DeclarationType>();
+            var->type->type = type;
+            var->ident = identifier(ident);
+            var->semiColon = semiColon;
+            return var;
         }
 
-        delete var;
-        formals.push_back(formalVar);
-    }
-    // leave rparen in token feed to be eaten by func decl
-
-    return formals;
-}
-
-
-Declarations* parseDecl()
-{
-    // Decide what type of decl 
-    
-    // useful hold for error printing of current token in lookahead
-    Scanner::Token token = tokenLookAhead->front();
-
-    // Here we need up to 3 tokens to determine which direction to go
-    addLookAhead(std::abs(3 - (tokenLookAheadIndex+1) ) );
-
-    Declarations* decl = nullptr;
-    if ( tokenLookAhead->at(2).getValue<std::string>().compare(";") == 0)
+        void setLoop(WhileStmt *stmt, Scanner::Token keyword, Scanner::Token lparen, Expression expr,
+                     Scanner::Token rparen, Statement body)
+        {
+            stmt->keyword = keyword;
+            stmt->lparen = lparen;
+            stmt->expr = expr;
+            stmt->rparen = rparen;
+            stmt->stmt = body;
+        }
+};
+
+// accepts every construct without making anything, each node is the builder itself
+class Recognizer {
+    public:
+        using Expression = Recognizer*;
+        using Statement = Recognizer*;
+        using Call = Recognizer*;
+        using Block = Recognizer*;
+        using Function = Recognizer*;
+        using Program = Recognizer*;
+
+        using Token = Scanner::Token;
+
+        Expression lvalue(Token) { return this; }
+        Expression constant(Token) { return this; }
+        Call call(Token, Token) { return this; }
+        void addActual(Call, Expression) {}
+        Expression closeCall(Call, Token) { return this; }
+        Expression paren(Token, Expression, Token) { return this; }
+        Expression unary(Token, Expression) { return this; }
+        Expression binary(Token, Expression, Expression) { return this; }
+
+        Statement expressionStmt(Expression, Token) { return this; }
+        Statement whileStmt(Token, Token, Expression, Token, Statement) { return this; }
+        Statement ifStmt(Token, Token, Expression, Token, Statement, Token, Statement) { return this; }
+        Statement forStmt(Token, Token, Expression, Token, Expression, Token, Expression, Token, Statement) { return this; }
+        Statement breakStmt(Token, Token) { return this; }
+        Statement returnStmt(Token, Expression, Token) { return this; }
+
+        Block block(Token) { return this; }
+        void addVariable(Block, Token, Token, Token) {}
+        void addStatement(Block, Statement) {}
+        Block closeBlock(Block, Token) { return this; }
+
+        Function function(Token, Token, Token) { return this; }
+        void addFormal(Function, Token, Token, Token) {}
+        void closeFunction(Function, Token, Block) {}
+
+        Program program() { return this; }
+        void addFunction(Program, Function) {}
+};
+
+
+    Program* treeGeneration(Scanner::Lexer *lexer, Common::Arena &arena, std::vector<ParseException> *errors)
     {
-        decl = parseVarDecl();
-
+        ParserContext context(lexer, errors);
+        ParseTreeBuilder builder(arena);
 
-        if (decl == nullptr)
-            throw Parser::ParseException(tokenLookAhead->at(0));
-        
-        takeTokens(3);  // take semi
-
-        return decl;
+        // Setup look ahead for certain parsing calls
+        context.addLookAhead();
+        return Parser::parseProgram(context, builder);
     }
-    else if (
-        tokenLookAhead->at(1).type == Scanner::Token::Type::Identifier &&
-        tokenLookAhead->at(2).type == Scanner::Token::Type::Separator &&
-        tokenLookAhead->at(2).getValue<std::string>().compare("(") == 0
-    )
-    {
-        ReturnType *type = new ReturnType();
-        Identifier *ident = new Identifier();
-        FunctionDeclaration *func = new FunctionDeclaration();
-
-        // setup return type node
-        type->type = token;
-
-        // setup ident
-        ident->ident = tokenLookAhead->at(1);
-        
-        
-        func->type = type;
-        func->ident = ident;
-        func->lparen = tokenLookAhead->at(2);
 
-        
-
-        takeTokens(3);
-
-        // should add tokens to lookup until see a rparen, for parsing validity
-        // before attempting to even verify formals are correct, but this is right 'recursive'
-
-        // Take tokens up to lparen, next lookahead should be start of formals
-        func->formals = parseFormals();
-        func->rparen = tokenLookAhead->front();
-        // take rparen
-        takeTokens(1);
-        func->block = parseStmtBlock();
-
-        if (func->block == nullptr)
-            throw std::runtime_error("Expected Closing brace to statement block");
-
-        return func;
-    }
-    else
+    void syntaxCheck(Scanner::Lexer *lexer, std::vector<ParseException> *errors)
     {
-        std::cout << "Decl: ";
-        // For testing we Are just going to destroy DeclType and eat the front token
-        std::cout << "Skipping Token: " << token;
-        takeTokens(1);
+        ParserContext context(lexer, errors);
+        Recognizer recognizer;
 
-        return nullptr;
+        // Setup look ahead for certain parsing calls
+        context.addLookAhead();
+        Parser::parseProgram(context, recognizer);
     }
 
-    return decl;
-}
-
-Program* parseProgram()
-{
-    // Program Decl Tree node
-    // ParseTree root;
-
-    Program *program = new Program();
-
-    while(tokenLookAhead->front().type != Scanner::Token::Type::END )
+    Program* parallelTreeGeneration(Scanner::Lexer *lexer, Common::Arena &arena, unsigned numThreads)
     {
-        Scanner::Token token = tokenLookAhead->front();
+        ParseTreeBuilder builder(arena);
 
-        switch(token.type)
-        {
-            case Scanner::Token::Type::Int:
-            case Scanner::Token::Type::Void:
-            case Scanner::Token::Type::Bool:
-            case Scanner::Token::Type::Double:
-            case Scanner::Token::Type::String:
-                {
-                    Declarations* decl = parseDecl();
-                    if (decl == nullptr)
-                        throw Parser::ParseException(tokenLookAhead->at(0));
-
-                    program->decls.push_back(decl);
-                }    
-                break;
-            default:
-                throw Parser::ParseException(tokenLookAhead->at(0));
-
-        }
+        return Parser::parseConcurrently(lexer, builder, arena,
+                                         [](Common::Arena &local) { return ParseTreeBuilder(local); }, numThreads);
     }
 
-    return program;
-}
-
-
-    Program* treeGeneration(Scanner::Lexer *lexer, bool print)
+    void parallelSyntaxCheck(Scanner::Lexer *lexer, unsigned numThreads)
     {
-        // Setup look ahead if necessary for certain parsing calls
-        if (Parser::tokenLookAhead == nullptr)
-        {
-            Parser::tokenLookAhead = new std::deque<Scanner::Token>();
-        }
-        
-        Parser::glexer = lexer;
-        try
-        {
-            Parser::addLookAhead();
-            Parser::Program* p = Parser::parseProgram();
-
-            if (print)
-                std::cout << std::endl << p->toString(0);
+        Common::Arena arena;
+        Recognizer recognizer;
 
-            return p;
-        }
-        catch( Scanner::GenericException &exc )
-        {
-            std::cout << exc.what() << std::endl;
-        }
-
-        return nullptr;
+        Parser::parseConcurrently(lexer, recognizer, arena,
+                                  [](Common::Arena &) { return Recognizer(); }, numThreads);
     }
 }
-
-
@@ -1,14 +1,60 @@
 #pragma once 
 
+#include <vector>
+
 #include "ParseTree.hpp"
+#include "exceptions.hpp"
+
+#include <common/Arena.hpp>
 
 #include "lexer/lexer.hpp"
 
 namespace Parser {
     /**
      * @brief Starts Parser Tree generation by taking in a lexer object for token stream
-     * 
-     * @param lexer 
+     *
+     *  Syntax errors throw ParseException, the first lexical error throws
+     *  the matching Scanner::GenericException. Given errors, the parse
+     *  instead recovers from each syntax error, keeps it there and carries on
+     *  to the end of input; the tree is then incomplete and should only be
+     *  used when errors stays empty. All parse state lives in a
+     *  ParserContext made for the call, so different lexers can be parsed on
+     *  separate threads at the same time.
+     *
+     * @param lexer
+     * @param arena the nodes are made in, the tree lives as long as it does
+     * @param errors where syntax errors are kept, null to throw the first
+     */
+    Program* treeGeneration(Scanner::Lexer *lexer, Common::Arena &arena,
+                            std::vector<ParseException> *errors=nullptr);
+
+    /**
+     * @brief Check the token stream of lexer parses without building a tree
+     *
+     *  Runs the grammar of treeGeneration and throws the same errors for the
+     *  same tokens, but allocates no nodes. Recovers into errors the same
+     *  way as well.
+     *
+     * @param lexer
+     * @param errors where syntax errors are kept, null to throw the first
      */
-    Program* treeGeneration(Scanner::Lexer *lexer, bool print=false);
+    void syntaxCheck(Scanner::Lexer *lexer, std::vector<ParseException> *errors=nullptr);
+
+    /**
+     * @brief treeGeneration with function bodies parsed on numThreads threads
+     *
+     *  The file is lexed in full first, then each top level function body
+     *  is parsed on whichever thread is free and the tree is put together in
+     *  source order. Makes the same tree and throws the same errors as
+     *  treeGeneration, a file with an error in it is parsed again in
+     *  sequence to find it. There is no recovery.
+     *
+     * @param lexer
+     * @param arena the nodes are made in, the tree lives as long as it does
+     * @param numThreads bodies are parsed on the calling thread below 2
+     */
+    Program* parallelTreeGeneration(Scanner::Lexer *lexer, Common::Arena &arena, unsigned numThreads);
+
+    // syntaxCheck with function bodies checked on numThreads threads
+    void parallelSyntaxCheck(Scanner::Lexer *lexer, unsigned numThreads);
 };
\ No newline at end of file
@@ -13,6 +13,8 @@ namespace Parser
         std::string message;
 
         public:
+            int lineNumber = 0;
+
             ParseException(char *msg) :
                 message(msg)
                 {
@@ -20,12 +22,13 @@ namespace Parser
                 };
 
             ParseException(Scanner::Token token )
+                : lineNumber(token.lineNumber())
                 {
                     std::stringstream ss;
                     
-                    ss << std::endl << "*** Error line " << token.lineNumber << "." << std::endl
-                        << token.lineInfo << std::endl
-                        << std::setw(token.colStart - 1) << " "
+                    ss << std::endl << "*** Error line " << token.lineNumber() << "." << std::endl
+                        << token.lineInfo() << std::endl
+                        << std::setw(token.colStart() - 1) << " "
                         << std::setfill('^') << std::setw(token.getValue<std::string>().length()) << "" << std::endl
                         << "*** syntax error" << std::endl;
                     
@@ -7,9 +7,9 @@
 
 namespace SemanticAnalyzer {
 
-    bool typeCheck(AST::Program *p)
+    bool typeCheck(AST::Program *p, Common::Diagnostics &diagnostics)
     {
-        STTypeVisitor visitor;
+        STTypeVisitor visitor(diagnostics);
         p->accept(&visitor);
 
         // returns true if type check passed
@@ -18,19 +18,21 @@ namespace SemanticAnalyzer {
 
     void STTypeVisitor::printTypeError(Scanner::Token token, std::string errStr)
     {
-        printTypeError(token.colStart - 1, token.getValue<std::string>().length(), 
-                        token.lineNumber, token.lineInfo, errStr);
+        printTypeError(token.colStart() - 1, token.getValue<std::string>().length(), 
+                        token.lineNumber(), token.lineInfo(), errStr);
     }
 
-    void STTypeVisitor::printTypeError(AST::Node* p, int lineNumber, std::string lineInfo, std::string errStr)
+    void STTypeVisitor::printTypeError(AST::Node* p, int lineNumber, std::string_view lineInfo, std::string errStr)
     {
         printTypeError(p->minCol() - 1, p->maxCol() - p->minCol(), lineNumber, lineInfo, errStr);
     }
 
-    void STTypeVisitor::printTypeError(int start, int length, int lineNumber, std::string lineInfo, std::string errStr)
+    void STTypeVisitor::printTypeError(int start, int length, int lineNumber, std::string_view lineInfo, std::string errStr)
     {
         err = true;
-        std::cout   << std::endl
+
+        std::stringstream ss;
+        ss          << std::endl
                     << "*** Error line " << lineNumber << ".\n"
                     <<  lineInfo << std::endl
                     << std::setw(start) << " "
@@ -38,7 +40,7 @@ namespace SemanticAnalyzer {
                     << "*** " << errStr << std::endl
                     << std::endl;
 
-        std::cout << std::setfill(' ');
+        diagnostics.report(Common::Diagnostics::Stage::Semantic, lineNumber, ss.str());
     }
 
 
@@ -96,13 +98,13 @@ namespace SemanticAnalyzer {
         // need to check if symbol is in table
         // std::cout << "Checking for symbol in table: " 
         //     << p->pScope->toString(space);
-        SymbolTable::IdEntry *entry = p->pScope->idLookup(p->value.getValue<std::string>());
+        SymbolTable::IdEntry *entry = p->pScope->idLookup(p->value.symbol());
 
         if (entry == nullptr || entry->func)
         {
             exprErr = true;
             // reset entry pointer to ensure pointer is valid
-            entry = p->pScope->fakeInstall(p->value.getValue<std::string>());
+            entry = p->pScope->fakeInstall(p->value);
             std::stringstream ss;
             ss << "No declaration found for variable '" << p->value.getValue<std::string>() << "'";
             printTypeError(p->value, ss.str());
@@ -114,7 +116,7 @@ namespace SemanticAnalyzer {
 
     void STTypeVisitor::visit(AST::Constant *p)
     {
-        switch(p->value.type)
+        switch(p->value.type())
         {
             case Scanner::Token::Type::IntConstant:
                 p->outType = Scanner::Token::Type::Int;
@@ -132,7 +134,7 @@ namespace SemanticAnalyzer {
                 p->outType = Scanner::Token::Type::Void;
                 break;
             default:
-                p->outType = p->value.type;
+                p->outType = p->value.type();
         }
     } 
 
@@ -472,7 +474,7 @@ namespace SemanticAnalyzer {
 
                     ss << "Incompatible argument " << i << ": " << ltype << " given, int/bool/string expected";
 
-                    printTypeError((*it), p->value.lineNumber, p->value.lineInfo, ss.str());
+                    printTypeError((*it), p->value.lineNumber(), p->value.lineInfo(), ss.str());
                     
                 }
 
@@ -485,7 +487,7 @@ namespace SemanticAnalyzer {
         SymbolTable::Scope *func( nullptr );
         try 
         {
-            SymbolTable::IdEntry *entry = p->pScope->idLookup(p->value.getValue<std::string>());
+            SymbolTable::IdEntry *entry = p->pScope->idLookup(p->value.symbol());
 
             if (entry == nullptr)
             {
@@ -535,7 +537,7 @@ namespace SemanticAnalyzer {
                             std::transform(rtype.begin(), rtype.end(), rtype.begin(), ::tolower);
                             
                             ss << "Incompatible argument " << i+1 << ": " << rtype << " given, " << ltype << " expected";
-                            printTypeError((*it), p->value.lineNumber, p->value.lineInfo, ss.str());
+                            printTypeError((*it), p->value.lineNumber(), p->value.lineInfo(), ss.str());
 
                             // if ( dynamic_cast<AST::Value*>((*it)) != nullptr )
                             // {
@@ -588,7 +590,7 @@ namespace SemanticAnalyzer {
             ss  << "Incompatible return: " 
                 << rtype << " given, " << ltype << " expected";
             
-            printTypeError(p->expr, p->value.lineNumber, p->value.lineInfo, ss.str());
+            printTypeError(p->expr, p->value.lineNumber(), p->value.lineInfo(), ss.str());
 
             // if (dynamic_cast<AST::Value*>(p->expr) != nullptr )
             //     printTypeError(dynamic_cast<AST::Value*>(p->expr)->value, ss.str());
@@ -613,7 +615,7 @@ namespace SemanticAnalyzer {
         {
             std::stringstream ss;
             ss << "Test expression must have boolean type";
-            printTypeError(p->expr, p->value.lineNumber, p->value.lineInfo, ss.str());
+            printTypeError(p->expr, p->value.lineNumber(), p->value.lineInfo(), ss.str());
         }
 
         exprErr = false;
@@ -634,7 +636,7 @@ namespace SemanticAnalyzer {
         {
             std::stringstream ss;
             ss << "Test expression must have boolean type";
-            printTypeError(p->expr, p->value.lineNumber, p->value.lineInfo, ss.str());
+            printTypeError(p->expr, p->value.lineNumber(), p->value.lineInfo(), ss.str());
         }
         // verify statement or statement block is type valid
         p->stmt->accept(this);
@@ -655,7 +657,12 @@ namespace SemanticAnalyzer {
         {
             std::stringstream ss;
             ss << "Test expression must have boolean type";
-            printTypeError(dynamic_cast<AST::Expr*>(p->expr)->op, ss.str());
+
+            // a test that is a lone value has no operator to point at
+            if (AST::Expr *expr = Common::dyn_cast<AST::Expr>(p->expr))
+                printTypeError(expr->op, ss.str());
+            else
+                printTypeError(p->expr, p->value.lineNumber(), p->value.lineInfo(), ss.str());
         }
         // verify statement or statement block is type valid
         p->stmt->accept(this);
@@ -665,7 +672,7 @@ namespace SemanticAnalyzer {
     void STTypeVisitor::visit(AST::FunctionDeclaration *p)
     {
         // scope should hold parameters to function
-        p->stmts->accept(this);
+        p->body()->accept(this);
     }
 
     void STTypeVisitor::visit(AST::Program *p)
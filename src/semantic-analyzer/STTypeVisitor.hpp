@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include <common/Diagnostics.hpp>
 #include <visitor/astVisitor.hpp>
 #include <AST/AbstractSyntaxTree.hpp>
 
@@ -11,15 +12,18 @@ namespace SemanticAnalyzer {
     class STTypeVisitor: public Visitor {
 
         public:
-            STTypeVisitor(): inLoop(false), err(false), exprErr(false) {};
+            STTypeVisitor(Common::Diagnostics &diagnostics)
+                : diagnostics(diagnostics), inLoop(false), err(false), exprErr(false) {};
+
+            Common::Diagnostics &diagnostics;
 
             bool inLoop;
             bool err;       // Set if error occurs, this will prevent code gen
             bool exprErr;
 
             void printTypeError(Scanner::Token token, std::string errStr);
-            void printTypeError(AST::Node* p, int lineNumber, std::string lineInfo, std::string errStr);
-            void printTypeError(int start, int end, int lineNumber, std::string lineInfo, std::string errStr);
+            void printTypeError(AST::Node* p, int lineNumber, std::string_view lineInfo, std::string errStr);
+            void printTypeError(int start, int end, int lineNumber, std::string_view lineInfo, std::string errStr);
 
             bool arithmeticCheck(Scanner::Token::Type type);
 
@@ -78,6 +82,6 @@ namespace SemanticAnalyzer {
     };
 
 
-    bool typeCheck(AST::Program *p);
+    bool typeCheck(AST::Program *p, Common::Diagnostics &diagnostics);
 
 };
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace Scanner {
+    /**
+     * @brief Start offset of every line read from a source file
+     *
+     *  One table per file, tokens only keep their line number and the text
+     *  of a line is cut out of the source when a diagnostic asks for it.
+     */
+    class LineTable {
+
+            std::string_view    text;
+            std::vector<std::size_t> starts;
+
+        public:
+            LineTable(std::string_view text)
+                : text(text)
+                , starts()
+            {};
+
+            // record where the next line (lineNumber == count() + 1) starts
+            void addLine(std::size_t offset) { starts.push_back(offset); };
+
+            std::size_t count() const { return starts.size(); };
+
+            /**
+             * @brief Text of a 1 based line without its new line
+             *
+             * @return std::string_view empty if line was never read
+             */
+            std::string_view line(int lineNumber) const
+            {
+                if (lineNumber < 1 || static_cast<std::size_t>(lineNumber) > starts.size())
+                    return std::string_view();
+
+                std::size_t start = starts[lineNumber - 1];
+                const void *newLine = std::memchr(text.data() + start, '\n', text.size() - start);
+                std::size_t end = newLine != nullptr ?
+                    static_cast<const char*>(newLine) - text.data() :
+                    text.size();
+
+                return text.substr(start, end - start);
+            };
+    };
+}
@@ -0,0 +1,25 @@
+#include "symbols.hpp"
+
+
+Scanner::Symbols::Symbols()
+    : names()
+    , ids()
+{
+    // order must match the builtin ids above
+    for (const char *builtin : { "Print", "ReadInteger", "ReadLine", "main" })
+        intern(builtin);
+}
+
+Scanner::SymbolId Scanner::Symbols::intern(std::string_view name)
+{
+    auto it = ids.find(name);
+    if (it != ids.end())
+        return it->second;
+
+    SymbolId id = names.size();
+
+    names.emplace_back(name);
+    ids.insert( {names.back(), id} );
+
+    return id;
+}
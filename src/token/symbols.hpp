@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Scanner {
+
+    // dense id for an interned identifier, equal names always share an id
+    typedef std::uint32_t SymbolId;
+
+    /**
+     * @brief Identifier interning pool of one compilation
+     *
+     *  The lexer interns every identifier so later stages compare and key
+     *  tables by SymbolId, the text is only fetched back for output. Ids are
+     *  handed out in order starting after the builtins below, which every
+     *  pool is seeded with, so they compare the same in any compilation.
+     *
+     *  A pool belongs to its Lexer and is released with it. It is not safe
+     *  to intern from several threads at once.
+     */
+    class Symbols {
+
+        public:
+            // pre-seeded names the compiler needs to recognize
+            enum : SymbolId {
+                Print,
+                ReadInteger,
+                ReadLine,
+                Main,
+
+                // not a symbol, used by tokens that are not identifiers
+                None = UINT32_MAX
+            };
+
+            Symbols();
+
+            Symbols(const Symbols&) = delete;
+            Symbols& operator=(const Symbols&) = delete;
+
+            SymbolId intern(std::string_view name);
+
+            // text of an interned id, must be an id returned by intern
+            std::string_view name(SymbolId id) const { return names[id]; };
+
+            // number of ids handed out so far
+            std::size_t size() const { return names.size(); };
+
+        private:
+            // deque so the strings (and views into them) never move as it grows
+            std::deque<std::string> names;
+            std::unordered_map<std::string_view, SymbolId> ids;
+    };
+}
@@ -1,100 +1,146 @@
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
 #include <iomanip>
 #include "token.hpp"
 
 
 namespace Scanner{
-std::map<Scanner::Token::Type, std::string> Scanner::Token::enumName{
-    {Type::Or, "Or"},
-    {Type::If, "If"},
-    {Type::Int, "Int"},
-    {Type::For, "For"},
-    {Type::And, "And"},
-    {Type::Else, "Else"},
-    {Type::Void, "Void"},
-    {Type::Bool, "Bool"},
-    {Type::Break, "Break"},
-    {Type::While, "While"},
-    {Type::Equal, "Equal"},
-    {Type::String, "String"},
-    {Type::Double, "Double"},
-    {Type::Return, "Return"},
-    {Type::NotEqual, "NotEqual"},
-    {Type::LessEqual, "LessEqual"},
-    {Type::Identifier, "Identifier"},
-    {Type::IntConstant, "IntConstant"},
-    {Type::BoolConstant, "BoolConstant"},
-    {Type::GreaterEqual, "GreaterEqual"},
-    {Type::DoubleConstant, "DoubleConstant"},
-    {Type::StringConstant, "StringConstant"},
-};
-
-std::map<std::string, Scanner::Token::Type> Scanner::Token::keywords{
-    {"if", Type::If},
-    {"int", Type::Int},
-    {"for", Type::For},
-    {"else", Type::Else},
-    {"void", Type::Void},
-    {"bool", Type::Bool},
-    {"break", Type::Break},
-    {"while", Type::While},
-    {"string", Type::String},
-    {"double", Type::Double},
-    {"return", Type::Return},
-    {"null", Type::NullConstant},
-    {"true", Type::BoolConstant},
-    {"false", Type::BoolConstant},
-};
-
-std::map<std::string, Scanner::Token::Type> Scanner::Token::operators{
-    {"!=", Type::NotEqual},
-    {"==", Type::Equal},
-    {">=", Type::GreaterEqual},
-    {"<=", Type::LessEqual},
-    {"||", Type::Or},
-    {"&&", Type::And},
-};
-
-std::map<std::string, Scanner::Token::SubType> Scanner::Token::subTypes{
-    {"(", SubType::Paren},
-    {")", SubType::Paren},
-    {",", SubType::Comma},
-    {"=", SubType::Assign},
-    {"!", SubType::Not},
-    {"+", SubType::Add},
-    {"-", SubType::Subtract},
-    {"*", SubType::Multiply},
-    {"/", SubType::Divide},
-    {"%", SubType::Modulus},
-    {"<", SubType::LessThan},
-    {"<=", SubType::LessEqual},
-    {">", SubType::GreaterThan},
-    {">=", SubType::GreaterEqual},
-    {"==", SubType::Equal},
-    {"!=", SubType::NotEqual},
-    {"&&", SubType::And},
-    {"||", SubType::Or},
-};
-
 int Scanner::Token::identifierMaxLength = 31;
 
+Scanner::Token Scanner::TokenStore::add(Token::Type type, Token::SubType subType, std::string_view value,
+    std::uint32_t slot, int lineNumber, int colStart)
+{
+    std::uint32_t index = types.size();
+
+    types.push_back(type);
+    subTypes.push_back(subType);
+    values.push_back(value);
+
+    if (type == Token::Type::IntConstant || type == Token::Type::DoubleConstant)
+    {
+        slots.push_back(literals.size());
+        literals.push_back(Token::parseLiteral(type, value));
+    }
+    else
+        slots.push_back(slot);
+
+    lineNumbers.push_back(lineNumber);
+    colStarts.push_back(colStart);
+
+    return Token(this, index);
+}
+
+void Scanner::TokenStore::append(const TokenStore &other, const std::vector<SymbolId> &symbolIds)
+{
+    types.insert(types.end(), other.types.begin(), other.types.end());
+    subTypes.insert(subTypes.end(), other.subTypes.begin(), other.subTypes.end());
+    values.insert(values.end(), other.values.begin(), other.values.end());
+
+    // literal indices move up past the literals already held, symbols are
+    // renumbered into this store's pool
+    std::uint32_t literalBase = literals.size();
+    for (std::size_t i = 0; i < other.size(); i++)
+    {
+        bool numeric = other.types[i] == Token::Type::IntConstant || other.types[i] == Token::Type::DoubleConstant;
+        if (numeric)
+            slots.push_back(other.slots[i] + literalBase);
+        else if (other.types[i] == Token::Type::Identifier)
+            slots.push_back(symbolIds[other.slots[i]]);
+        else
+            slots.push_back(other.slots[i]);
+    }
+    literals.insert(literals.end(), other.literals.begin(), other.literals.end());
+
+    lineNumbers.insert(lineNumbers.end(), other.lineNumbers.begin(), other.lineNumbers.end());
+    colStarts.insert(colStarts.end(), other.colStarts.begin(), other.colStarts.end());
+}
+
+void Scanner::TokenStore::reserve(std::size_t numTokens)
+{
+    types.reserve(numTokens);
+    subTypes.reserve(numTokens);
+    values.reserve(numTokens);
+    slots.reserve(numTokens);
+    lineNumbers.reserve(numTokens);
+    colStarts.reserve(numTokens);
+}
+
+std::size_t Scanner::TokenStore::memoryUsage() const
+{
+    return types.capacity() * sizeof(Token::Type)
+        + subTypes.capacity() * sizeof(Token::SubType)
+        + values.capacity() * sizeof(std::string_view)
+        + slots.capacity() * sizeof(std::uint32_t)
+        + lineNumbers.capacity() * sizeof(int)
+        + colStarts.capacity() * sizeof(int)
+        + literals.capacity() * sizeof(Token::Literal);
+}
+
 template<>
 const std::string Scanner::Token::getValue() const
 {
-    return (type == Type::Identifier) ?
-        value.substr(0, Token::identifierMaxLength) :
-        value;
+    std::string_view text = value();
+
+    return std::string( (type() == Type::Identifier) ?
+        text.substr(0, Token::identifierMaxLength) :
+        text );
+}
+
+Scanner::Token::Literal Scanner::Token::parseLiteral(Type type, std::string_view text)
+{
+    Literal literal{};
+
+    if (type == Type::IntConstant)
+    {
+        // lexer only hands over digits, saturate like strtol then narrow like atoi
+        unsigned long long value = 0;
+        for (char c : text)
+        {
+            if (c < '0' || c > '9')
+                break;
+
+            unsigned long long digit = c - '0';
+            if (value > (LONG_MAX - digit) / 10)
+            {
+                value = LONG_MAX;
+                literal.truncated = true;
+            }
+            else
+                value = value * 10 + digit;
+        }
+
+        literal.intValue = static_cast<int>(static_cast<long>(value));
+        literal.overflow = value > INT_MAX;
+    }
+    else
+    {
+        const char *end = text.data() + text.size();
+        std::from_chars_result result = std::from_chars(text.data(), end, literal.doubleValue);
+
+        // from_chars leaves the value alone when out of range, strtod rounds it
+        if (result.ec == std::errc::result_out_of_range)
+        {
+            literal.doubleValue = std::strtod(std::string(text).c_str(), nullptr);
+            literal.overflow = std::isinf(literal.doubleValue);
+            literal.truncated = !literal.overflow;
+        }
+    }
+
+    return literal;
 }
 
 template<>
 const double Scanner::Token::getValue() const
 {
-    return std::atof(value.c_str());
+    return (store != nullptr) ? literal().doubleValue : 0.0;
 }
 
 template<>
 const int Scanner::Token::getValue() const
 {
-    return std::atoi(value.c_str());
+    return (store != nullptr) ? literal().intValue : 0;
 }
 
 }
@@ -102,37 +148,37 @@ const int Scanner::Token::getValue() const
 std::ostream& operator<<(std::ostream &out, Scanner::Token const& token)
 {
     // if end token don't print anything
-    if (token.type == Scanner::Token::Type::END)
+    if (token.type() == Scanner::Token::Type::END)
         return out;
 
     // print token first with set spacing
-    out << token.value << std::setw(20)
-        << "line " << token.lineNumber << " cols " << token.colStart << "-"
-        << (token.colStart + token.value.length()) - 1 << " is " ;
+    out << token.value() << std::setw(20)
+        << "line " << token.lineNumber() << " cols " << token.colStart() << "-"
+        << (token.colStart() + token.value().length()) - 1 << " is " ;
 
-    switch (token.type) {
+    switch (token.type()) {
         case Scanner::Token::Type::Separator:
         case Scanner::Token::Type::Operator:
             out << "\'" << token.getValue<std::string>()  << "\'";
             break;
         case Scanner::Token::Type::BoolConstant:
         case Scanner::Token::Type::StringConstant:
-            out << Scanner::Token::getTTypeName(token.type) << " (value = " << token.getValue<std::string>() << ")";
+            out << Scanner::Token::getTTypeName(token.type()) << " (value = " << token.getValue<std::string>() << ")";
             break;
         case Scanner::Token::Type::IntConstant:
-            out << Scanner::Token::getTTypeName(token.type) << " (value = " << token.getValue<int>() << ")";
+            out << Scanner::Token::getTTypeName(token.type()) << " (value = " << token.getValue<int>() << ")";
             break;
         case Scanner::Token::Type::DoubleConstant:
-            out << Scanner::Token::getTTypeName(token.type) << " (value = " << token.getValue<double>() << ")";
+            out << Scanner::Token::getTTypeName(token.type()) << " (value = " << token.getValue<double>() << ")";
             break;
         case Scanner::Token::Type::Identifier:
-            out << Scanner::Token::getTTypeName(token.type);
-            if (token.value.length() > Scanner::Token::identifierMaxLength)
+            out << Scanner::Token::getTTypeName(token.type());
+            if (token.value().length() > static_cast<std::size_t>(Scanner::Token::identifierMaxLength))
                 out << "(truncated to " + token.getValue<std::string>() + ")";
             break;
 
         default:
-            out << Scanner::Token::getTTypeName(token.type);
+            out << Scanner::Token::getTTypeName(token.type());
         // ommitting default case here since we may add other token types with different
         // print options
     };
@@ -1,15 +1,31 @@
 #pragma once
 
+#include <cstdint>
 #include <ostream>
 #include <string>
-#include <map>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "lines.hpp"
+#include "symbols.hpp"
 
 namespace Scanner {
+    class TokenStore;
+
+    /**
+     * @brief Handle to a token held in a TokenStore
+     *
+     *  Tokens are copied by value all over the parser and AST, so a token is
+     *  only a store pointer and an index, the fields live in the store. A
+     *  token with no store (default, or built from just a Type) is detached
+     *  and reports only its type.
+     */
     class Token {
 
 
         public:
-        enum class Type {
+        enum class Type : std::uint8_t {
             // Special ERROR to allow printing of errors without breaking main loop
             ERROR,
 
@@ -57,9 +73,8 @@ namespace Scanner {
             END
         };
 
-        enum class SubType {
+        enum class SubType : std::uint8_t {
             Operand,
-            Call,
             Assign,
             Paren,
             Comma,
@@ -77,10 +92,48 @@ namespace Scanner {
             Multiply,
             Modulus,
             Not,
-            UnaryNegative,
         };
 
-        static std::map<Type, std::string> enumName;
+        // what went wrong for an ERROR token, the token value is the offending text
+        enum class Error : std::uint8_t {
+            UnrecognizedChar,
+            UnterminatedString,
+        };
+
+        // printable names indexed by Type, types without a name print as ERROR
+        static constexpr std::string_view enumName[] = {
+            "ERROR",            // ERROR
+            "ERROR",            // EMPTY
+            "ERROR",            // Operator
+            "ERROR",            // Separator
+            "IntConstant",
+            "ERROR",            // NullConstant
+            "BoolConstant",
+            "DoubleConstant",
+            "StringConstant",
+            "Identifier",
+            "Int",
+            "Void",
+            "Bool",
+            "Double",
+            "String",
+            "If",
+            "For",
+            "Else",
+            "Break",
+            "While",
+            "Return",
+            "Or",
+            "And",
+            "Equal",
+            "NotEqual",
+            "LessEqual",
+            "GreaterEqual",
+            "ERROR",            // END
+        };
+
+        static_assert(sizeof(enumName) / sizeof(enumName[0]) == static_cast<int>(Type::END) + 1,
+            "enumName must have an entry for every Type");
 
         static int identifierMaxLength;
 
@@ -89,59 +142,270 @@ namespace Scanner {
         };
 
         static std::string getTypeName(const Type &type) {
-            return (enumName.find(type) != enumName.end()) ? 
-                enumName.find(type)->second :
-                std::string("ERROR");
+            return std::string(enumName[static_cast<int>(type)]);
         };
 
-        // usefule identifier keywords for quick lookup
-        static std::map<std::string, Type> keywords;
+        // result of a reserved word lookup, found is false if text is not reserved
+        struct Lexeme {
+            Type type;
+            SubType subType;
+            bool found;
+        };
+
+        /**
+         * @brief Value of an IntConstant or DoubleConstant, converted once by the lexer
+         *
+         *  Ints keep what atoi would give for the text (wrapped when out of
+         *  range). overflow is set when the literal is beyond the range of its
+         *  type, truncated when precision was lost on the way (an int past the
+         *  range of long, or a non zero double that rounded to zero or a
+         *  denormal).
+         */
+        struct Literal {
+            union {
+                int     intValue;
+                double  doubleValue;
+            };
+            bool    overflow;
+            bool    truncated;
+        };
+
+        // convert constant text, allocation free for every literal that is in range
+        static Literal parseLiteral(Type type, std::string_view text);
+
+        /**
+         * @brief Look up keyword type for identifier text
+         *
+         *  Switches on length first so at most a few comparisons are made,
+         *  constants (null/true/false) are treated as keywords.
+         */
+        static constexpr Lexeme lookupKeyword(std::string_view text) {
+            switch (text.length())
+            {
+                case 2:
+                    if (text == "if")       return { Type::If, SubType::Operand, true };
+                    break;
+                case 3:
+                    if (text == "int")      return { Type::Int, SubType::Operand, true };
+                    if (text == "for")      return { Type::For, SubType::Operand, true };
+                    break;
+                case 4:
+                    if (text == "else")     return { Type::Else, SubType::Operand, true };
+                    if (text == "void")     return { Type::Void, SubType::Operand, true };
+                    if (text == "bool")     return { Type::Bool, SubType::Operand, true };
+                    if (text == "null")     return { Type::NullConstant, SubType::Operand, true };
+                    if (text == "true")     return { Type::BoolConstant, SubType::Operand, true };
+                    break;
+                case 5:
+                    if (text == "break")    return { Type::Break, SubType::Operand, true };
+                    if (text == "while")    return { Type::While, SubType::Operand, true };
+                    if (text == "false")    return { Type::BoolConstant, SubType::Operand, true };
+                    break;
+                case 6:
+                    if (text == "string")   return { Type::String, SubType::Operand, true };
+                    if (text == "double")   return { Type::Double, SubType::Operand, true };
+                    if (text == "return")   return { Type::Return, SubType::Operand, true };
+                    break;
+            }
 
-        // useful multiple character operators for quick lookup
-        static std::map<std::string, Type> operators;
+            return { Type::Identifier, SubType::Operand, false };
+        };
 
-        static std::map<std::string, SubType> subTypes;
+        /**
+         * @brief Look up type and sub type for operator or separator text
+         *
+         *  Single characters are always an Operator or Separator, the two
+         *  character operators each have their own type.
+         */
+        static constexpr Lexeme lookupOperator(std::string_view text) {
+            if (text.length() == 1)
+            {
+                switch (text[0])
+                {
+                    case '(':
+                    case ')': return { Type::Separator, SubType::Paren, true };
+                    case ',': return { Type::Separator, SubType::Comma, true };
+                    case ';':
+                    case '.':
+                    case '{':
+                    case '}': return { Type::Separator, SubType::Operand, true };
+                    case '=': return { Type::Operator, SubType::Assign, true };
+                    case '!': return { Type::Operator, SubType::Not, true };
+                    case '+': return { Type::Operator, SubType::Add, true };
+                    case '-': return { Type::Operator, SubType::Subtract, true };
+                    case '*': return { Type::Operator, SubType::Multiply, true };
+                    case '/': return { Type::Operator, SubType::Divide, true };
+                    case '%': return { Type::Operator, SubType::Modulus, true };
+                    case '<': return { Type::Operator, SubType::LessThan, true };
+                    case '>': return { Type::Operator, SubType::GreaterThan, true };
+                    case '&':
+                    case '|': return { Type::Operator, SubType::Operand, true };
+                }
+            }
+            else if (text.length() == 2 && text[1] == '=')
+            {
+                switch (text[0])
+                {
+                    case '!': return { Type::NotEqual, SubType::NotEqual, true };
+                    case '=': return { Type::Equal, SubType::Equal, true };
+                    case '>': return { Type::GreaterEqual, SubType::GreaterEqual, true };
+                    case '<': return { Type::LessEqual, SubType::LessEqual, true };
+                }
+            }
+            else if (text == "||")
+                return { Type::Or, SubType::Or, true };
+            else if (text == "&&")
+                return { Type::And, SubType::And, true };
 
-        Type type;
-        SubType subType;
-        std::string value;
-        std::string lineInfo;
-        int lineNumber;
-        int colStart;       // only column start since column end can be inferred by colStart + tokenString.len()
+            return { Type::ERROR, SubType::Operand, false };
+        };
 
-        Token():
-            type(Type::END),
-            subType(SubType::Operand),
-            value(""),
-            lineNumber(-1),
-            colStart(-1)
+        Token()
+            : store(nullptr)
+            , index(0)
+            , detached(Type::END)
         {};
 
         Token(Scanner::Token::Type type)
-            : type(type)
-            , subType(SubType::Operand)
-            , value("")
-            , lineNumber(-1)
-            , colStart(-1)
+            : store(nullptr)
+            , index(0)
+            , detached(type)
+        {};
+
+        Token(const TokenStore *store, std::uint32_t index)
+            : store(store)
+            , index(index)
+            , detached(Type::END)
         {};
 
+        Type type() const;
+        SubType subType() const;
+        std::string_view value() const;     // view into the lexer's source buffer
+        SymbolId symbol() const;            // interned (truncated) name, Symbols::None unless an Identifier
+        const Literal & literal() const;    // only valid for IntConstant and DoubleConstant
+        Error error() const;                // only valid for ERROR
+        int lineNumber() const;
+        int colStart() const;       // only column start since column end can be inferred by colStart + value.len()
 
         template<typename TokenValue>
         const TokenValue getValue() const;
 
-        bool operator== (const Token& o)
+        // full source line the token is on, only looked up for diagnostics
+        std::string_view lineInfo() const;
+
+        bool operator== (const Token& o) const
         {
-            if (
-                type == o.type &&
-                value.compare(o.value) == 0 &&
-                lineNumber == o.lineNumber &&
-                colStart == o.colStart
-            )
-                return true;
-
-            return false;
+            return store == o.store && index == o.index && detached == o.detached;
         };
+
+        private:
+        const TokenStore *store;
+        std::uint32_t   index;
+        Type            detached;   // type of a token with no store
     };
+
+    static_assert(std::is_trivially_copyable<Token>::value, "Token must stay a plain handle");
+    static_assert(sizeof(Token) <= 16, "Token handle should fit in 16 bytes");
+
+    /**
+     * @brief Fields of every token lexed from one file, one column per field
+     *
+     *  Owned by the Lexer, so tokens (and their values) must not outlive it.
+     */
+    class TokenStore {
+
+            std::vector<Token::Type>        types;
+            std::vector<Token::SubType>     subTypes;
+            std::vector<std::string_view>   values;
+            // symbol of an identifier, index into literals of a numeric constant,
+            // Error of an ERROR token
+            std::vector<std::uint32_t>      slots;
+            std::vector<int>                lineNumbers;
+            std::vector<int>                colStarts;
+
+            // values of numeric constants only, most tokens have none
+            std::vector<Token::Literal>     literals;
+
+            const LineTable                 *lines;
+
+            friend class Token;
+
+        public:
+            TokenStore(const LineTable *lines)
+                : lines(lines)
+            {};
+
+            TokenStore(const TokenStore&) = delete;
+            TokenStore& operator=(const TokenStore&) = delete;
+
+            // slot is the symbol of an Identifier or the Error of an ERROR token
+            Token add(Token::Type type, Token::SubType subType, std::string_view value,
+                std::uint32_t slot, int lineNumber, int colStart);
+
+            void reserve(std::size_t numTokens);
+
+            // add every token of other to the end of this store, symbolIds maps
+            // the symbols of its identifiers to the ones of this store's pool
+            void append(const TokenStore &other, const std::vector<SymbolId> &symbolIds);
+
+            void setValue(std::uint32_t index, std::string_view value) { values[index] = value; };
+
+            std::size_t size() const { return types.size(); };
+
+            Token operator[](std::uint32_t index) const { return Token(this, index); };
+
+            // bytes held by the columns (capacity, not just size)
+            std::size_t memoryUsage() const;
+    };
+
+    inline Token::Type Token::type() const
+    {
+        return (store != nullptr) ? store->types[index] : detached;
+    }
+
+    inline Token::SubType Token::subType() const
+    {
+        return (store != nullptr) ? store->subTypes[index] : SubType::Operand;
+    }
+
+    inline std::string_view Token::value() const
+    {
+        return (store != nullptr) ? store->values[index] : std::string_view("");
+    }
+
+    inline SymbolId Token::symbol() const
+    {
+        return (store != nullptr && store->types[index] == Type::Identifier) ?
+            store->slots[index] :
+            Symbols::None;
+    }
+
+    inline const Token::Literal & Token::literal() const
+    {
+        return store->literals[store->slots[index]];
+    }
+
+    inline Token::Error Token::error() const
+    {
+        return static_cast<Error>(store->slots[index]);
+    }
+
+    inline int Token::lineNumber() const
+    {
+        return (store != nullptr) ? store->lineNumbers[index] : -1;
+    }
+
+    inline int Token::colStart() const
+    {
+        return (store != nullptr) ? store->colStarts[index] : -1;
+    }
+
+    inline std::string_view Token::lineInfo() const
+    {
+        return (store != nullptr && store->lines != nullptr) ?
+            store->lines->line(lineNumber()) :
+            std::string_view();
+    }
 }
 
 std::ostream& operator<<(std::ostream &out, Scanner::Token const& token);
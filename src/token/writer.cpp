@@ -0,0 +1,172 @@
+#include <charconv>
+#include <cstring>
+
+#include "writer.hpp"
+
+
+namespace {
+    // "line " right aligned in 20 columns, as setw(20) prints it
+    constexpr std::string_view linePrefix = "               line ";
+}
+
+Scanner::TokenWriter::TokenWriter(std::ostream &out, std::size_t capacity)
+    : out(out)
+    , buffer(capacity)
+    , used(0)
+{
+}
+
+Scanner::TokenWriter::~TokenWriter()
+{
+    flush();
+}
+
+void Scanner::TokenWriter::flush()
+{
+    if (used > 0)
+        out.write(buffer.data(), used);
+
+    used = 0;
+}
+
+char * Scanner::TokenWriter::reserve(std::size_t length)
+{
+    if (buffer.size() - used < length)
+        flush();
+
+    return buffer.data() + used;
+}
+
+void Scanner::TokenWriter::write(std::string_view text)
+{
+    if (buffer.size() - used < text.size())
+    {
+        flush();
+
+        // too big to ever fit, skip the copy
+        if (text.size() > buffer.size())
+        {
+            out.write(text.data(), text.size());
+            return;
+        }
+    }
+
+    std::memcpy(buffer.data() + used, text.data(), text.size());
+    used += text.size();
+}
+
+void Scanner::TokenWriter::write(char c)
+{
+    *reserve(1) = c;
+    used++;
+}
+
+void Scanner::TokenWriter::writeTypeName(Token::Type type)
+{
+    // getTTypeName without building a string
+    write("T_");
+    write(Token::enumName[static_cast<int>(type)]);
+}
+
+void Scanner::TokenWriter::writeNumber(long long value)
+{
+    const std::size_t maxLength = 24;
+    char *start = reserve(maxLength);
+
+    used += std::to_chars(start, start + maxLength, value).ptr - start;
+}
+
+void Scanner::TokenWriter::writeNumber(double value)
+{
+    // general format with precision 6 is what ostream prints by default
+    const std::size_t maxLength = 32;
+    char *start = reserve(maxLength);
+
+    used += std::to_chars(start, start + maxLength, value, std::chars_format::general, 6).ptr - start;
+}
+
+void Scanner::TokenWriter::write(const Token &token)
+{
+    Token::Type type = token.type();
+
+    if (type == Token::Type::END)
+        return;
+
+    std::string_view value = token.value();
+
+    // lexer errors print as the message alone, same text as the lexer's exceptions
+    if (type == Token::Type::ERROR)
+    {
+        write("\n*** Error line ");
+        writeNumber(static_cast<long long>(token.lineNumber()));
+        write(".\n");
+
+        write(token.error() == Token::Error::UnterminatedString ?
+            "*** Unterminated string constant: " :
+            "*** Unrecognized char: \'");
+
+        // the message was printed as a C string, so it ends at a NUL in the text
+        std::size_t nul = value.find('\0');
+        if (nul != std::string_view::npos)
+        {
+            write(value.substr(0, nul));
+            write('\n');
+            return;
+        }
+
+        write(value);
+        write(token.error() == Token::Error::UnterminatedString ? "\n\n" : "\'\n\n");
+        return;
+    }
+
+    write(value);
+    write(linePrefix);
+    writeNumber(static_cast<long long>(token.lineNumber()));
+    write(" cols ");
+    writeNumber(static_cast<long long>(token.colStart()));
+    write('-');
+    writeNumber(static_cast<long long>(token.colStart() + value.length() - 1));
+    write(" is ");
+
+    switch (type) {
+        case Token::Type::Separator:
+        case Token::Type::Operator:
+            write('\'');
+            write(value);
+            write('\'');
+            break;
+        case Token::Type::BoolConstant:
+        case Token::Type::StringConstant:
+            writeTypeName(type);
+            write(" (value = ");
+            write(value);
+            write(')');
+            break;
+        case Token::Type::IntConstant:
+            writeTypeName(type);
+            write(" (value = ");
+            writeNumber(static_cast<long long>(token.getValue<int>()));
+            write(')');
+            break;
+        case Token::Type::DoubleConstant:
+            writeTypeName(type);
+            write(" (value = ");
+            writeNumber(token.getValue<double>());
+            write(')');
+            break;
+        case Token::Type::Identifier:
+            writeTypeName(type);
+            if (value.length() > static_cast<std::size_t>(Token::identifierMaxLength))
+            {
+                write("(truncated to ");
+                write(value.substr(0, Token::identifierMaxLength));
+                write(')');
+            }
+            break;
+
+        default:
+            writeTypeName(type);
+    };
+
+    write('\n');
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "token.hpp"
+
+namespace Scanner {
+    /**
+     * @brief Formats tokens the same as operator<< into one reusable buffer
+     *
+     *  Nothing is allocated per token, type names are fixed strings and
+     *  numbers are converted in place. The buffer is handed to the stream in
+     *  large blocks when full and when the writer is flushed or destroyed.
+     */
+    class TokenWriter {
+
+            std::ostream        &out;
+            std::vector<char>   buffer;
+            std::size_t         used;
+
+            // make room for length more bytes, flushing if they don't fit
+            char * reserve(std::size_t length);
+
+            void writeTypeName(Token::Type type);
+            void writeNumber(long long value);
+            void writeNumber(double value);
+
+        public:
+            TokenWriter(std::ostream &out, std::size_t capacity = 1 << 20);
+            ~TokenWriter();
+
+            TokenWriter(const TokenWriter&) = delete;
+            TokenWriter& operator=(const TokenWriter&) = delete;
+
+            // one line per token, END writes nothing and ERROR writes its message
+            void write(const Token &token);
+
+            // raw text such as a diagnostic message
+            void write(std::string_view text);
+            void write(char c);
+
+            void flush();
+    };
+}
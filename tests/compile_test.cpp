@@ -0,0 +1,195 @@
+#include "acutest.h"
+#include "compile.hpp"
+#include <common/Arena.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+std::string helper_read(std::string file)
+{
+    std::ifstream in(file);
+    std::stringstream text;
+
+    text << in.rdbuf();
+    return text.str();
+}
+
+void test_compile_repeatable(void)
+{
+    std::string source( helper_read("samples/codegen/t1.decaf") );
+
+    Decaf::Result first = Decaf::compile(source);
+    Decaf::Result second = Decaf::compile(source);
+
+    TEST_CHECK(first.success && second.success);
+    TEST_CHECK(! first.assembly.empty());
+
+    // labels and registers start over for each compile
+    TEST_CHECK(first.assembly == second.assembly);
+    TEST_CHECK(first.output.empty());
+}
+
+void test_compile_diagnostics(void)
+{
+    std::string source( helper_read("samples/semantic/bad1.decaf") );
+
+    Decaf::Options options;
+    options.mode = Decaf::Mode::SemanticCheck;
+
+    Decaf::Result result = Decaf::compile(source, options);
+
+    TEST_CHECK(! result.success);
+    TEST_CHECK(! result.stopped);
+    TEST_CHECK(result.assembly.empty());
+    TEST_ASSERT(result.diagnostics.size() == 1);
+    TEST_CHECK(result.diagnostics[0].stage == Common::Diagnostics::Stage::Semantic);
+    TEST_CHECK(result.diagnostics[0].lineNumber == 6);
+    TEST_CHECK(result.output == result.diagnostics[0].message);
+
+    // a lexical error stops before parsing rather than crashing
+    options.mode = Decaf::Mode::CodeGen;
+    result = Decaf::compile("void main() { string s; s = \"open; }\n", options);
+
+    TEST_CHECK(result.stopped);
+    TEST_ASSERT(result.diagnostics.size() == 1);
+    TEST_CHECK(result.diagnostics[0].stage == Common::Diagnostics::Stage::Lexer);
+    TEST_CHECK(result.diagnostics[0].lineNumber == 1);
+
+    // recovering reports every syntax error and still stops before the later stages
+    options.recover = true;
+    result = Decaf::compile(helper_read("samples/parser/bad4.decaf"), options);
+
+    TEST_CHECK(result.stopped);
+    TEST_CHECK(result.assembly.empty());
+    TEST_ASSERT(result.diagnostics.size() == 2);
+    TEST_CHECK(result.diagnostics[0].stage == Common::Diagnostics::Stage::Parser);
+    TEST_CHECK(result.diagnostics[0].lineNumber == 2);
+    TEST_CHECK(result.diagnostics[1].lineNumber == 4);
+
+    // statements missing a part are syntax errors in every mode
+    options.recover = false;
+    const char *incomplete[] = {
+        "void main() {\n while () x = 1; }\n",
+        "void main() {\n if (x) else x = 1; }\n",
+        "void main() {\n for (; ; ) x = 1; }\n",
+    };
+
+    for (const char *source : incomplete)
+    {
+        result = Decaf::compile(source, options);
+
+        TEST_CHECK(result.stopped);
+        TEST_ASSERT(result.diagnostics.size() == 1);
+        TEST_CHECK(result.diagnostics[0].stage == Common::Diagnostics::Stage::Parser);
+        TEST_CHECK(result.diagnostics[0].lineNumber == 2);
+        TEST_MSG("%s%s", source, result.output.c_str());
+    }
+}
+
+void test_compile_signatures(void)
+{
+    // bodies are never parsed, so the error in one goes unnoticed
+    std::string source =
+        "int count;\n"
+        "void report(string name, int n) {\n    Print(name, n, );\n}\n"
+        "double ratio(int a, int b) { return a / ; }\n"
+        "bool done;\n";
+
+    Decaf::Options options;
+    options.mode = Decaf::Mode::Signatures;
+
+    Decaf::Result result = Decaf::compile(source, options);
+
+    TEST_CHECK(result.success);
+    TEST_CHECK(result.output ==
+        "  1 int count\n"
+        "  2 void report(string name, int n)\n"
+        "  5 double ratio(int a, int b)\n"
+        "  6 bool done\n");
+    TEST_MSG("%s", result.output.c_str());
+
+    // the global symbol table is still built and checked
+    result = Decaf::compile(source + "int count;\n", options);
+
+    TEST_CHECK(result.stopped);
+    TEST_ASSERT(result.diagnostics.size() == 1);
+    TEST_CHECK(result.diagnostics[0].stage == Common::Diagnostics::Stage::SymbolTable);
+    TEST_CHECK(result.diagnostics[0].lineNumber == 7);
+
+    // a lexical error in a body is still reported, as in every other mode
+    result = Decaf::compile("void main() {\n int x;\n x = 1 @ 2;\n}\n", options);
+
+    TEST_CHECK(result.stopped);
+    TEST_ASSERT(result.diagnostics.size() == 1);
+    TEST_CHECK(result.diagnostics[0].stage == Common::Diagnostics::Stage::Lexer);
+    TEST_CHECK(result.diagnostics[0].lineNumber == 3);
+}
+
+// records the order instances are destroyed in
+struct Tracked {
+    std::vector<int> &destroyed;
+    int id;
+    std::string padding;
+
+    Tracked(std::vector<int> &destroyed, int id) : destroyed(destroyed), id(id), padding(100, 'x') {};
+    ~Tracked() { destroyed.push_back(id); };
+};
+
+void test_arena_release(void)
+{
+    std::vector<int> destroyed;
+    Common::Arena arena(256);
+
+    for (int i = 0; i < 100; i++)
+        TEST_CHECK(arena.make<Tracked>(destroyed, i)->id == i);
+
+    // larger than a block, and aligned like anything else
+    double *big = static_cast<double*>(arena.allocate(4096, alignof(double)));
+    big[511] = 1.0;
+    TEST_CHECK(reinterpret_cast<std::uintptr_t>(big) % alignof(double) == 0);
+
+    TEST_CHECK(arena.size() > 1);
+    TEST_CHECK(destroyed.empty());
+
+    arena.release();
+
+    // everything destroyed at once, newest first
+    TEST_ASSERT(destroyed.size() == 100);
+    TEST_CHECK(destroyed.front() == 99 && destroyed.back() == 0);
+    TEST_CHECK(arena.size() == 0);
+
+    // usable again after a release
+    TEST_CHECK(*arena.make<int>(7) == 7);
+
+    // objects made in another arena are released with the one adopting them
+    destroyed.clear();
+    {
+        Common::Arena other(256);
+
+        for (int i = 0; i < 10; i++)
+            other.make<Tracked>(destroyed, i);
+
+        std::size_t numBlocks = arena.size() + other.size();
+        arena.adopt(other);
+
+        TEST_CHECK(other.size() == 0);
+        TEST_CHECK(arena.size() == numBlocks);
+    }
+
+    TEST_CHECK(destroyed.empty());
+    TEST_CHECK(*arena.make<int>(8) == 8);
+
+    arena.release();
+    TEST_CHECK(destroyed.size() == 10);
+}
+
+TEST_LIST = {
+    { "compile_repeatable", test_compile_repeatable},
+    { "compile_diagnostics", test_compile_diagnostics},
+    { "arena_release", test_arena_release},
+    { "compile_signatures", test_compile_signatures},
+    { NULL, NULL }
+
+};
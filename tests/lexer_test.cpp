@@ -1,9 +1,16 @@
 #include "acutest.h"
 #include "lexer.hpp"
+#include "scan.hpp"
 #include <exception>
 #include <stdexcept>
 #include <string>
 #include <vector>
+#include <cstdio>
+#include <thread>
+#include <algorithm>
+#include <unistd.h>
+#include <cstdlib>
+#include <cmath>
 
 
 using namespace Scanner;
@@ -39,11 +46,316 @@ void test_working_files(void)
     }
 }
 
+void test_empty_file(void)
+{
+    // zero length files cannot be mapped, lexer should still hit END
+    std::string filepath("./empty.frag");
+    std::FILE *f = std::fopen(filepath.c_str(), "w");
+    std::fclose(f);
+
+    {
+        Lexer lexer(filepath);
+        TEST_CHECK(lexer.getNextToken().type() == Token::Type::END);
+    }
+
+    std::remove(filepath.c_str());
+}
+
+void test_token_views(void)
+{
+    Lexer lexer("./samples/lexer/program.decaf");
+
+    Token token = lexer.getNextToken();
+    TEST_CHECK(token.type() == Token::Type::Int);
+    TEST_CHECK(token.value() == "int");
+
+    token = lexer.getNextToken();
+    TEST_CHECK(token.type() == Token::Type::Identifier);
+    TEST_CHECK(token.value() == "a");
+    TEST_CHECK(token.colStart() == 5);
+}
+
+void test_reserved_lookup(void)
+{
+    // lookups are constexpr so they can be checked at compile time as well
+    static_assert(Token::lookupKeyword("while").type == Token::Type::While, "while keyword");
+    static_assert(!Token::lookupKeyword("whiles").found, "whiles is an identifier");
+
+    TEST_CHECK(Token::lookupKeyword("null").type == Token::Type::NullConstant);
+    TEST_CHECK(Token::lookupKeyword("false").type == Token::Type::BoolConstant);
+    TEST_CHECK(!Token::lookupKeyword("Print").found);
+
+    Token::Lexeme op = Token::lookupOperator("<=");
+    TEST_CHECK(op.type == Token::Type::LessEqual && op.subType == Token::SubType::LessEqual);
+
+    op = Token::lookupOperator("(");
+    TEST_CHECK(op.type == Token::Type::Separator && op.subType == Token::SubType::Paren);
+
+    TEST_CHECK(!Token::lookupOperator("=<").found);
+    TEST_CHECK(Token::getTypeName(Token::Type::GreaterEqual) == "GreaterEqual");
+    TEST_CHECK(Token::getTypeName(Token::Type::END) == "ERROR");
+}
+
+void test_symbol_interning(void)
+{
+    Symbols symbols;
+
+    TEST_CHECK(symbols.intern("Print") == Symbols::Print);
+    TEST_CHECK(symbols.intern("main") == Symbols::Main);
+    TEST_CHECK(symbols.name(Symbols::ReadLine) == "ReadLine");
+
+    SymbolId id = symbols.intern("interned_name");
+    TEST_CHECK(symbols.intern(std::string("interned_") + "name") == id);
+    TEST_CHECK(symbols.name(id) == "interned_name");
+    TEST_CHECK(symbols.intern("interned_other") != id);
+
+    // each lexer interns into its own pool, seeded with the same builtins
+    Lexer lexer("./samples/lexer/program.decaf");
+
+    Token token = lexer.getNextToken();
+    TEST_CHECK(token.symbol() == Symbols::None);
+
+    token = lexer.getNextToken();
+    TEST_CHECK(lexer.symbols().name(token.symbol()) == "a");
+    TEST_CHECK(lexer.symbols().size() == Symbols::Main + 2);
+}
+
+void test_tokenize_all(void)
+{
+    std::size_t count = 0;
+    {
+        Lexer lexer("./samples/lexer/program.decaf");
+        while (lexer.getNextToken().type() != Token::Type::END)
+            count++;
+    }
+
+    Lexer lexer("./samples/lexer/program.decaf");
+    const TokenStore &tokens = lexer.tokenizeAll();
+
+    TEST_CHECK(tokens.size() == count);
+    TEST_CHECK(tokens[0].type() == Token::Type::Int);
+    TEST_CHECK(lexer.diagnostics().empty());
+
+    // errors come back as tokens in place of the exception
+    Lexer bad("./samples/lexer/badstring.frag");
+    const TokenStore &badTokens = bad.tokenizeAll();
+
+    TEST_CHECK(badTokens[0].type() == Token::Type::ERROR);
+    TEST_CHECK(badTokens[0].error() == Token::Error::UnterminatedString);
+    TEST_CHECK(badTokens[0].lineNumber() == 3);
+    TEST_CHECK(bad.diagnostics().empty());
+}
+
+void test_numeric_literals(void)
+{
+    Token::Literal literal = Token::parseLiteral(Token::Type::IntConstant, "2147483647");
+    TEST_CHECK(literal.intValue == 2147483647 && !literal.overflow && !literal.truncated);
+
+    // out of range ints keep what atoi gives
+    literal = Token::parseLiteral(Token::Type::IntConstant, "2147483648");
+    TEST_CHECK(literal.intValue == std::atoi("2147483648") && literal.overflow && !literal.truncated);
+
+    literal = Token::parseLiteral(Token::Type::IntConstant, "99999999999999999999");
+    TEST_CHECK(literal.intValue == std::atoi("99999999999999999999") && literal.overflow && literal.truncated);
+
+    literal = Token::parseLiteral(Token::Type::DoubleConstant, "1.5E+3");
+    TEST_CHECK(literal.doubleValue == 1500.0 && !literal.overflow && !literal.truncated);
+
+    literal = Token::parseLiteral(Token::Type::DoubleConstant, "1.0E999");
+    TEST_CHECK(std::isinf(literal.doubleValue) && literal.overflow);
+
+    literal = Token::parseLiteral(Token::Type::DoubleConstant, "1.0E-999");
+    TEST_CHECK(literal.doubleValue == 0.0 && literal.truncated);
+
+    // lexer stores the value with the token
+    Lexer lexer("./samples/lexer/number.frag");
+    const TokenStore &tokens = lexer.tokenizeAll();
+    for (std::uint32_t i = 0; i < tokens.size(); i++)
+    {
+        std::string text(tokens[i].value());
+
+        if (tokens[i].type() == Token::Type::IntConstant)
+            TEST_CHECK(tokens[i].getValue<int>() == std::atoi(text.c_str()));
+        else if (tokens[i].type() == Token::Type::DoubleConstant)
+            TEST_CHECK(tokens[i].getValue<double>() == std::atof(text.c_str()));
+    }
+}
+
+// every field of every token and message must match between two lexers
+void check_same_tokens(Lexer &serial, Lexer &parallel)
+{
+    const TokenStore &a = serial.tokenizeAll();
+    const TokenStore &b = parallel.tokenizeAll();
+
+    TEST_CHECK(a.size() == b.size());
+    for (std::uint32_t i = 0; i < a.size() && i < b.size(); i++)
+    {
+        TEST_CHECK(a[i].type() == b[i].type());
+        TEST_CHECK(a[i].subType() == b[i].subType());
+        TEST_CHECK(a[i].value() == b[i].value());
+        TEST_CHECK(a[i].symbol() == b[i].symbol());
+        TEST_CHECK(a[i].lineNumber() == b[i].lineNumber());
+        TEST_CHECK(a[i].colStart() == b[i].colStart());
+        TEST_CHECK(a[i].lineInfo() == b[i].lineInfo());
+        if (a[i].type() == Token::Type::DoubleConstant && b[i].type() == Token::Type::DoubleConstant)
+            TEST_CHECK(a[i].getValue<double>() == b[i].getValue<double>());
+        if (a[i].type() == Token::Type::IntConstant && b[i].type() == Token::Type::IntConstant)
+            TEST_CHECK(a[i].getValue<int>() == b[i].getValue<int>());
+        TEST_MSG("token %u", i);
+    }
+
+    TEST_CHECK(serial.diagnostics().size() == parallel.diagnostics().size());
+    for (std::size_t i = 0; i < serial.diagnostics().size() && i < parallel.diagnostics().size(); i++)
+    {
+        TEST_CHECK(serial.diagnostics()[i].before == parallel.diagnostics()[i].before);
+        TEST_CHECK(serial.diagnostics()[i].message == parallel.diagnostics()[i].message);
+    }
+}
+
+void test_parallel_lexing(void)
+{
+    // comments spanning chunks, opened both on blank lines and after a token
+    std::string filepath("./parallel.frag");
+    std::string text;
+    const char *lines[] = {
+        "int a = 1; /* open",
+        "x = 2;",
+        "still * in / it */ y = 3;",
+        "/* starts",
+        "   a line",
+        "*/",
+        "  /* indented",
+        "z; *",
+        "b = \"str\" + 1.5E+3;",
+        "ident_that_is_far_too_long_to_be_valid_here = 0;",
+        "\"unterminated",
+        "c = a & b; d = a && b;",
+        "",
+        "\t",
+        "e = 12.;",
+        "f = x /* short */ + y; // line",
+    };
+
+    for (int i = 0; i < 400; i++)
+    {
+        text += lines[(i * 7) % 16];
+        text += (i % 50 == 49) ? std::string(1, '\0') + "q\n" : "\n";
+    }
+    text += "/* never closed\nint";
+
+    std::FILE *f = std::fopen(filepath.c_str(), "w");
+    std::fwrite(text.data(), 1, text.size(), f);
+    std::fclose(f);
+
+    for (unsigned threads : { 2u, 3u, 8u })
+    {
+        Lexer serial(filepath);
+        serial.setParallelism(1);
+
+        Lexer parallel(filepath);
+        parallel.setParallelism(threads, 0);
+
+        check_same_tokens(serial, parallel);
+    }
+
+    std::remove(filepath.c_str());
+
+    Lexer serial("./samples/lexer/program.decaf");
+    serial.setParallelism(1);
+
+    Lexer parallel("./samples/lexer/program.decaf");
+    parallel.setParallelism(4, 0);
+
+    check_same_tokens(serial, parallel);
+}
+
+void test_pipe_source(void)
+{
+    // larger than the first read buffer so it has to grow
+    std::string text;
+    while (text.size() < (3 << 20))
+        text += "int x; /* comment */ x = 12 + 3.5E+2;\n";
+
+    int fds[2];
+    TEST_ASSERT(::pipe(fds) == 0);
+
+    std::thread writer([&]() {
+        for (std::size_t written = 0; written < text.size(); )
+        {
+            ssize_t numWritten = ::write(fds[1], text.data() + written, std::min<std::size_t>(4096, text.size() - written));
+            if (numWritten <= 0)
+                break;
+            written += numWritten;
+        }
+        ::close(fds[1]);
+    });
+
+    {
+        SourceBuffer source(fds[0]);
+        writer.join();
+
+        TEST_CHECK(source.view() == text);
+    }
+    ::close(fds[0]);
+
+    // lexing a pipe by path gives the same tokens as lexing a file
+    TEST_ASSERT(::pipe(fds) == 0);
+    std::FILE *f = std::fopen("./samples/lexer/program.decaf", "rb");
+    std::string program;
+    for (int c; (c = std::fgetc(f)) != EOF; )
+        program += static_cast<char>(c);
+    std::fclose(f);
+
+    TEST_ASSERT(::write(fds[1], program.data(), program.size()) == static_cast<ssize_t>(program.size()));
+    ::close(fds[1]);
+
+    Lexer piped("/dev/fd/" + std::to_string(fds[0]));
+    ::close(fds[0]);
+    Lexer file("./samples/lexer/program.decaf");
+
+    check_same_tokens(file, piped);
+}
+
+void test_scan_kernels(void)
+{
+    // runs of every length around the vector widths, at every alignment
+    const char fill[] = { ' ', '\t', '\n' };
+    char buffer[128];
+
+    for (int length = 0; length < 80; length++)
+    {
+        for (int offset = 0; offset < 32; offset++)
+        {
+            for (int i = 0; i < length; i++)
+                buffer[offset + i] = fill[(i * 7 + offset) % 3];
+            buffer[offset + length] = (length % 2) ? 'x' : '/';
+
+            const char *begin = buffer + offset;
+            const char *end = begin + length + 1;
+
+            TEST_CHECK(Scan::skipWhiteSpace(begin, end) == Scan::skipWhiteSpaceScalar(begin, end));
+            TEST_CHECK(Scan::skipWhiteSpace(begin, end - 1) == end - 1);
+            TEST_CHECK(Scan::find(begin, end, '/') == Scan::findScalar(begin, end, '/'));
+        }
+    }
+
+    TEST_MSG("kernels: %s", Scan::kernelName());
+}
+
 
 TEST_LIST = {
     { "bad_file", test_invalid_file},
     { "good_file", test_valid_file},
     { "good_files", test_working_files},
+    { "empty_file", test_empty_file},
+    { "token_views", test_token_views},
+    { "reserved_lookup", test_reserved_lookup},
+    { "symbol_interning", test_symbol_interning},
+    { "tokenize_all", test_tokenize_all},
+    { "scan_kernels", test_scan_kernels},
+    { "parallel_lexing", test_parallel_lexing},
+    { "numeric_literals", test_numeric_literals},
+    { "pipe_source", test_pipe_source},
     { NULL, NULL }
 
 };
@@ -0,0 +1,601 @@
+#include "acutest.h"
+#include "TreeGeneration.hpp"
+#include "exceptions.hpp"
+#include "ParseTreePrinter.hpp"
+#include <AST/ASTGeneration.hpp>
+#include <lexer/exceptions.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+
+// parse tree text of a file, or the message of the error that stopped it
+std::string helper_parse(const std::string &file)
+{
+    Scanner::Lexer lexer(file);
+    Common::Arena arena;
+
+    try {
+        Parser::Program *program = Parser::treeGeneration(&lexer, arena);
+        return program->toString(0);
+    }
+    catch (Parser::ParseException &exc)
+    {
+        return exc.what();
+    }
+    catch (Scanner::GenericException &exc)
+    {
+        return exc.what();
+    }
+}
+
+// helper_parse for a single statement in the body of main, lexed from memory
+std::string helper_parse_statement(const std::string &statement)
+{
+    std::string source = "void main() {\n    " + statement + "\n}\n";
+    Scanner::Lexer lexer(source.data(), source.data() + source.size());
+    Common::Arena arena;
+
+    try {
+        Parser::Program *program = Parser::treeGeneration(&lexer, arena);
+        return program->toString(0);
+    }
+    catch (Parser::ParseException &exc)
+    {
+        return exc.what();
+    }
+}
+
+// isa on node agrees with dynamic_cast for every class listed
+template <class... Classes, class Node>
+void helper_kinds(Node *node)
+{
+    bool agree[] = { (Common::isa<Classes>(node) == (dynamic_cast<Classes*>(node) != nullptr))... };
+    const char *names[] = { typeid(Classes).name()... };
+
+    for (std::size_t i = 0; i < sizeof...(Classes); i++)
+    {
+        TEST_CHECK(agree[i]);
+        TEST_MSG("kind %d, class %s", static_cast<int>(node->kind()), names[i]);
+    }
+}
+
+void helper_parse_kinds(Parser::ParseNode *node)
+{
+    helper_kinds<Parser::Identifier, Parser::DeclarationType, Parser::ReturnType, Parser::Statement,
+        Parser::Declarations, Parser::Expression, Parser::BinaryExpression, Parser::UnaryExpression,
+        Parser::AssignExpression, Parser::ArithmeticExpression, Parser::LogicalExpression,
+        Parser::RelationalExpression, Parser::EqualityExpression, Parser::ParenExpr, Parser::LValue,
+        Parser::Constant, Parser::VariableDeclaration, Parser::StatementBlock,
+        Parser::FormalVariableDeclaration, Parser::FunctionDeclaration, Parser::CallExpression,
+        Parser::PrintStmt, Parser::ReadIntExpr, Parser::ReadLineExpr, Parser::KeywordStmt,
+        Parser::ReturnStmt, Parser::BreakStmt, Parser::WhileStmt, Parser::IfStmt, Parser::ForStmt,
+        Parser::Program>(node);
+}
+
+void helper_ast_kinds(AST::Node *node)
+{
+    helper_kinds<AST::Value, AST::Declaration, AST::StatementBlock, AST::FunctionDeclaration,
+        AST::Ident, AST::Constant, AST::Call, AST::Expr, AST::KeywordStmt, AST::Add, AST::Subtract,
+        AST::Multiply, AST::Divide, AST::Modulus, AST::LessThan, AST::LTE, AST::GreaterThan, AST::GTE,
+        AST::Equal, AST::NotEqual, AST::And, AST::Or, AST::Not, AST::Assign, AST::Break, AST::Return,
+        AST::While, AST::If, AST::For, AST::Print, AST::ReadInteger, AST::ReadLine, AST::Program>(node);
+}
+
+// message of the error that stops parsing file straight to an AST, empty if none
+std::string helper_ast_error(const std::string &file)
+{
+    Scanner::Lexer lexer(file);
+    Common::Arena arena;
+
+    try {
+        AST::astGeneration(&lexer, arena);
+        return "";
+    }
+    catch (Parser::ParseException &exc)
+    {
+        return exc.what();
+    }
+    catch (Scanner::GenericException &exc)
+    {
+        return exc.what();
+    }
+}
+
+std::string helper_syntax_error(const std::string &file)
+{
+    Scanner::Lexer lexer(file);
+
+    try {
+        Parser::syntaxCheck(&lexer);
+        return "";
+    }
+    catch (Parser::ParseException &exc)
+    {
+        return exc.what();
+    }
+    catch (Scanner::GenericException &exc)
+    {
+        return exc.what();
+    }
+}
+
+void test_expression_parsing(void)
+{
+    const char *valid[] = {
+        "x = (((a + c) * b) - c);",
+        "x = (a) - b;",
+        "x = f(a, -b) - !c;",
+        "while ((a) < b) x = 1;",
+        "Print(a, (b), f());",
+        "(a) - b;",
+        "(1 + 2);",
+        "(\"hello world\");",
+        "x = 1;;",
+    };
+
+    for (const char *statement : valid)
+    {
+        std::string tree = helper_parse_statement(statement);
+        TEST_CHECK(tree.find("*** syntax error") == std::string::npos);
+        TEST_MSG("%s%s", statement, tree.c_str());
+    }
+
+    // equal binding power groups to the right, as parser output always has
+    std::string tree = helper_parse_statement("x = a - b + c;");
+    TEST_CHECK(tree.find("Identifier: a") < tree.find("ArithmeticExpr", tree.find("Operator: -")));
+
+    // a statement may start with a parenthesized expression
+    tree = helper_parse_statement("(a) - b;");
+    TEST_CHECK(tree.find("ArithmeticExpr") != std::string::npos);
+    TEST_CHECK(tree.find("Identifier: b") != std::string::npos);
+
+    // the token reported for each error is underlined on the line after the source
+    const std::pair<const char *, const char *> invalid[] = {
+        { "x = a < b < c;",     "              ^\n" },
+        { "x = a + ;",          "          ^\n" },
+        { "x = f(a, );",        "           ^\n" },
+        { "Print();",           "         ^\n" },
+        { "a + b = c;",         "    ^\n" },
+        { "x = a b;",           "          ^\n" },
+        { "break x;",           "          ^\n" },
+        { "while () x = 1;",    "           ^\n" },
+    };
+
+    for (const auto &[statement, caret] : invalid)
+    {
+        std::string error = helper_parse_statement(statement);
+        TEST_CHECK(error.find(std::string("\n    ") + statement + "\n" + caret) != std::string::npos);
+        TEST_MSG("%s%s", statement, error.c_str());
+    }
+}
+
+void test_concurrent_parse(void)
+{
+    std::vector<std::string> files;
+
+    for (auto &entry : std::filesystem::recursive_directory_iterator("samples"))
+    {
+        if (entry.path().extension() == ".decaf")
+            files.push_back(entry.path().string());
+    }
+
+    std::sort(files.begin(), files.end());
+    TEST_ASSERT(files.size() > 10);
+
+    std::vector<std::string> expected;
+
+    for (const std::string &file : files)
+        expected.push_back(helper_parse(file));
+
+    const unsigned numThreads = 8;
+    const unsigned rounds = 4;
+    std::vector<std::vector<std::string>> results(numThreads, std::vector<std::string>(files.size()));
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([&, t]() {
+            // each thread starts at a different file so parses overlap differently
+            for (unsigned round = 0; round < rounds; round++)
+            {
+                for (std::size_t i = 0; i < files.size(); i++)
+                {
+                    std::size_t index = (i + t) % files.size();
+                    results[t][index] = helper_parse(files[index]);
+                }
+            }
+        });
+    }
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (unsigned t = 0; t < numThreads; t++)
+    {
+        for (std::size_t i = 0; i < files.size(); i++)
+        {
+            TEST_CHECK(results[t][i] == expected[i]);
+            TEST_MSG("thread %u, file %s", t, files[i].c_str());
+        }
+    }
+}
+
+void test_ast_generation(void)
+{
+    std::size_t numErrors = 0;
+
+    for (auto &entry : std::filesystem::recursive_directory_iterator("samples"))
+    {
+        if (entry.path().extension() != ".decaf")
+            continue;
+
+        std::string file = entry.path().string();
+        std::string tree = helper_parse(file);
+        std::string error = helper_ast_error(file);
+
+        // a parse tree is printed from "Program:", anything else is the error
+        if (tree.find("Program:") == std::string::npos)
+        {
+            TEST_CHECK(error == tree);
+            numErrors++;
+        }
+        else
+            TEST_CHECK(error.empty());
+
+        TEST_MSG("file %s%s", file.c_str(), error.c_str());
+    }
+
+    // the samples have syntax errors for both parsers to agree on
+    TEST_CHECK(numErrors > 0);
+}
+
+void test_syntax_only(void)
+{
+    for (auto &entry : std::filesystem::recursive_directory_iterator("samples"))
+    {
+        if (entry.path().extension() != ".decaf")
+            continue;
+
+        std::string file = entry.path().string();
+        std::string tree = helper_parse(file);
+        std::string error = helper_syntax_error(file);
+
+        // the recognizer stops on the same token the tree builder does
+        if (tree.find("Program:") == std::string::npos)
+            TEST_CHECK(error == tree);
+        else
+            TEST_CHECK(error.empty());
+
+        TEST_MSG("file %s%s", file.c_str(), error.c_str());
+    }
+}
+
+// messages of the syntax errors recovered from while parsing source each way
+std::vector<std::vector<std::string>> helper_recover(const std::string &source)
+{
+    std::vector<std::vector<std::string>> messages;
+
+    for (int way = 0; way < 3; way++)
+    {
+        Scanner::Lexer lexer(source.data(), source.data() + source.size());
+        Common::Arena arena;
+        std::vector<Parser::ParseException> errors;
+
+        if (way == 0)
+            Parser::treeGeneration(&lexer, arena, &errors);
+        else if (way == 1)
+            AST::astGeneration(&lexer, arena, &errors);
+        else
+            Parser::syntaxCheck(&lexer, &errors);
+
+        messages.emplace_back();
+
+        for (Parser::ParseException &error : errors)
+            messages.back().push_back(error.what());
+    }
+
+    return messages;
+}
+
+void test_error_recovery(void)
+{
+    const std::string source =
+        "void main() {\n"
+        "  int a;\n"
+        "  a = ;\n"
+        "  Print(a)\n"
+        "  a = 3;\n"
+        "  if (a) { b = 1 +; }\n"
+        "}\n"
+        "int 5;\n"
+        "void f(int a b) { return; }\n"
+        "void g() { x = a * b; }\n";
+
+    std::vector<std::vector<std::string>> messages = helper_recover(source);
+
+    // a statement, the one after a missing semicolon, a nested block, then
+    // declarations, and nothing from the good function at the end
+    const int lines[] = { 3, 5, 6, 8, 9 };
+
+    TEST_ASSERT(messages[0].size() == 5);
+
+    for (std::size_t i = 0; i < 5; i++)
+    {
+        TEST_CHECK(messages[0][i].find("*** Error line " + std::to_string(lines[i]) + ".") == 1);
+        TEST_MSG("error %zu%s", i, messages[0][i].c_str());
+    }
+
+    TEST_CHECK(messages[1] == messages[0]);
+    TEST_CHECK(messages[2] == messages[0]);
+
+    // input ending inside a block is reported after what came before it
+    messages = helper_recover("void main() {\n  a = ;\n  b = 1;\n");
+    TEST_CHECK(messages[0].size() == 2);
+    TEST_CHECK(messages[2] == messages[0]);
+
+    // the first error recovered from is the one that stops a parse without recovery
+    for (auto &entry : std::filesystem::recursive_directory_iterator("samples"))
+    {
+        if (entry.path().extension() != ".decaf")
+            continue;
+
+        std::string file = entry.path().string();
+        std::string tree = helper_parse(file);
+
+        if (tree.find("*** syntax error") == std::string::npos)
+            continue;
+
+        Scanner::Lexer lexer(file);
+        Common::Arena arena;
+        std::vector<Parser::ParseException> errors;
+
+        Parser::treeGeneration(&lexer, arena, &errors);
+
+        TEST_CHECK(! errors.empty() && tree == errors[0].what());
+        TEST_MSG("file %s%s", file.c_str(), tree.c_str());
+    }
+}
+
+void test_tree_printer(void)
+{
+    // deep enough that copying each level's text would show
+    std::string expr = "1";
+
+    for (int i = 0; i < 200; i++)
+        expr = "(a - " + expr + ")";
+
+    std::string source = "void main() {\n    x = " + expr + ";\n}\n";
+    Scanner::Lexer lexer(source.data(), source.data() + source.size());
+    Common::Arena arena;
+
+    Parser::Program *program = Parser::treeGeneration(&lexer, arena);
+
+    // a buffer smaller than most lines, so nearly every write flushes
+    std::ostringstream out;
+    {
+        Parser::ParseTreePrinter printer(out, 16);
+        printer.print(program);
+    }
+
+    TEST_CHECK(out.str() == program->toString());
+
+    // the innermost constant is 3 columns in for each level under the function
+    std::string last = "  2" + std::string(3 * 204, ' ') + "IntConstant: 1\n";
+    TEST_CHECK(out.str().find(last) != std::string::npos);
+    TEST_MSG("%s", out.str().substr(out.str().size() - 700).c_str());
+}
+
+// tree text or error of parsing source with bodies on numThreads threads, or
+// in sequence when numThreads is 0, and the number of lexer messages kept
+std::pair<std::string, std::size_t> helper_parallel_parse(const std::string &source, unsigned numThreads)
+{
+    Scanner::Lexer lexer(source.data(), source.data() + source.size());
+    Common::Arena arena;
+    std::string result;
+
+    lexer.keepDiagnostics(true);
+
+    try {
+        Parser::Program *program = (numThreads == 0) ?
+            Parser::treeGeneration(&lexer, arena) :
+            Parser::parallelTreeGeneration(&lexer, arena, numThreads);
+
+        result = program->toString(0);
+    }
+    catch (Parser::ParseException &exc)
+    {
+        result = exc.what();
+    }
+    catch (Scanner::GenericException &exc)
+    {
+        result = exc.what();
+    }
+
+    return {result, lexer.diagnostics().size()};
+}
+
+void test_parallel_parse(void)
+{
+    for (auto &entry : std::filesystem::recursive_directory_iterator("samples"))
+    {
+        if (entry.path().extension() != ".decaf")
+            continue;
+
+        std::string file = entry.path().string();
+        std::string tree = helper_parse(file);
+
+        Scanner::Lexer lexer(file);
+        Common::Arena arena;
+        std::string parallel;
+
+        try {
+            parallel = Parser::parallelTreeGeneration(&lexer, arena, 4)->toString(0);
+        }
+        catch (Parser::ParseException &exc)
+        {
+            parallel = exc.what();
+        }
+        catch (Scanner::GenericException &exc)
+        {
+            parallel = exc.what();
+        }
+
+        TEST_CHECK(parallel == tree);
+        TEST_MSG("file %s", file.c_str());
+    }
+
+    // many functions, with unary minus and calls for the parse to refine
+    std::string source = "int g;\n";
+
+    for (int i = 0; i < 200; i++)
+    {
+        std::string name = "f" + std::to_string(i);
+        source += "int " + name + "(int a) {\n    if (a > 0) {\n        return -" + name + "(a - 1);\n    }\n"
+                  "    while (a < 0) { a = a + 1; }\n    return a;\n}\n";
+    }
+
+    auto expected = helper_parallel_parse(source, 0);
+    TEST_CHECK(expected.first.find("Program:") != std::string::npos);
+
+    for (unsigned numThreads : {1u, 2u, 8u})
+    {
+        auto result = helper_parallel_parse(source, numThreads);
+        TEST_CHECK(result == expected);
+        TEST_MSG("%u threads", numThreads);
+    }
+
+    // an error in one body is found by parsing in sequence, lexer messages
+    // after it are dropped as if the lexer had stopped there
+    std::string longName(Scanner::Token::identifierMaxLength + 10, 'x');
+    std::string broken = source;
+
+    broken.replace(broken.find("f20(a - 1)"), 3, longName);
+    broken.replace(broken.find("f150(a - 1)"), 11, "f150(a - )");
+    broken.replace(broken.find("f180(a - 1)"), 4, longName);
+
+    expected = helper_parallel_parse(broken, 0);
+    TEST_CHECK(expected.first.find("*** syntax error") != std::string::npos);
+    TEST_CHECK(expected.second == 1);
+
+    for (unsigned numThreads : {1u, 2u, 8u})
+    {
+        auto result = helper_parallel_parse(broken, numThreads);
+        TEST_CHECK(result == expected);
+        TEST_MSG("%u threads: %s", numThreads, result.first.c_str());
+    }
+}
+
+void test_lazy_bodies(void)
+{
+    for (auto &entry : std::filesystem::recursive_directory_iterator("samples"))
+    {
+        if (entry.path().extension() != ".decaf")
+            continue;
+
+        std::string file = entry.path().string();
+        std::string error = helper_ast_error(file);
+
+        Scanner::Lexer lexer(file);
+        Common::Arena arena;
+        std::string lazyError;
+        std::size_t numLazy = 0;
+
+        try {
+            AST::Program *program = AST::signatureGeneration(&lexer, arena);
+
+            for (AST::Node *node : program->func)
+            {
+                AST::FunctionDeclaration *func = Common::cast<AST::FunctionDeclaration>(node);
+
+                numLazy += (func->lazy != nullptr && func->stmts == nullptr);
+
+                // parsed once, then kept
+                AST::StatementBlock *body = func->body();
+                TEST_CHECK(body != nullptr && func->lazy == nullptr && func->body() == body);
+            }
+
+            TEST_CHECK(numLazy == program->func.size());
+        }
+        catch (Parser::ParseException &exc)
+        {
+            lazyError = exc.what();
+        }
+        catch (Scanner::GenericException &exc)
+        {
+            lazyError = exc.what();
+        }
+
+        // the same errors as parsing it all at once, only found later
+        TEST_CHECK(lazyError == error);
+        TEST_MSG("file %s%s%s", file.c_str(), error.c_str(), lazyError.c_str());
+    }
+}
+
+void test_node_kinds(void)
+{
+    Common::Arena arena;
+
+    // one of each class that can be made, checked against every class
+    Parser::ParseNode *parseNodes[] = {
+        arena.make<Parser::Identifier>(), arena.make<Parser::DeclarationType>(),
+        arena.make<Parser::ReturnType>(), arena.make<Parser::UnaryExpression>(),
+        arena.make<Parser::AssignExpression>(), arena.make<Parser::ArithmeticExpression>(),
+        arena.make<Parser::LogicalExpression>(), arena.make<Parser::RelationalExpression>(),
+        arena.make<Parser::EqualityExpression>(), arena.make<Parser::ParenExpr>(),
+        arena.make<Parser::LValue>(), arena.make<Parser::Constant>(),
+        arena.make<Parser::VariableDeclaration>(), arena.make<Parser::StatementBlock>(),
+        arena.make<Parser::FormalVariableDeclaration>(), arena.make<Parser::FunctionDeclaration>(),
+        arena.make<Parser::CallExpression>(), arena.make<Parser::PrintStmt>(),
+        arena.make<Parser::ReadIntExpr>(), arena.make<Parser::ReadLineExpr>(),
+        arena.make<Parser::ReturnStmt>(), arena.make<Parser::BreakStmt>(),
+        arena.make<Parser::WhileStmt>(), arena.make<Parser::IfStmt>(),
+        arena.make<Parser::ForStmt>(), arena.make<Parser::Program>(),
+    };
+
+    for (Parser::ParseNode *node : parseNodes)
+        helper_parse_kinds(node);
+
+    AST::Node *astNodes[] = {
+        arena.make<AST::Declaration>(), arena.make<AST::StatementBlock>(),
+        arena.make<AST::FunctionDeclaration>(), arena.make<AST::Ident>(Scanner::Token()),
+        arena.make<AST::Constant>(Scanner::Token()), arena.make<AST::Call>(),
+        arena.make<AST::Add>(), arena.make<AST::Subtract>(), arena.make<AST::Multiply>(),
+        arena.make<AST::Divide>(), arena.make<AST::Modulus>(), arena.make<AST::LessThan>(),
+        arena.make<AST::LTE>(), arena.make<AST::GreaterThan>(), arena.make<AST::GTE>(),
+        arena.make<AST::Equal>(), arena.make<AST::NotEqual>(), arena.make<AST::And>(),
+        arena.make<AST::Or>(), arena.make<AST::Not>(), arena.make<AST::Assign>(),
+        arena.make<AST::Break>(), arena.make<AST::Return>(), arena.make<AST::While>(),
+        arena.make<AST::If>(), arena.make<AST::For>(), arena.make<AST::Print>(),
+        arena.make<AST::ReadInteger>(), arena.make<AST::ReadLine>(), arena.make<AST::Program>(),
+    };
+
+    for (AST::Node *node : astNodes)
+        helper_ast_kinds(node);
+
+    // the tree the parser builds carries the same kinds
+    Scanner::Lexer lexer("samples/parser/functions.decaf");
+    AST::Program *program = AST::astGeneration(&lexer, arena);
+
+    for (AST::Node *func : program->func)
+        TEST_CHECK(Common::isa<AST::FunctionDeclaration>(func) && Common::isa<AST::Declaration>(func));
+}
+
+TEST_LIST = {
+    { "expression_parsing", test_expression_parsing},
+    { "concurrent_parse", test_concurrent_parse},
+    { "ast_generation", test_ast_generation},
+    { "syntax_only", test_syntax_only},
+    { "error_recovery", test_error_recovery},
+    { "tree_printer", test_tree_printer},
+    { "parallel_parse", test_parallel_parse},
+    { "lazy_bodies", test_lazy_bodies},
+    { "node_kinds", test_node_kinds},
+    { NULL, NULL }
+
+};
@@ -43,7 +43,7 @@ else
     done
 
     echo "Running g++ build"
-    g++ --std=c++11 build/*.cpp -o ./decaf-22 
+    g++ --std=c++17 build/*.cpp -o ./decaf-22 
 
     cp ./decaf-22 ./workdir/
 fi